@@ -0,0 +1,364 @@
+﻿#pragma once
+#include "vector.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Арена (bump-аллокатор): память выделяется сдвигом указателя внутри крупных блоков
+// и возвращается целиком при разрушении арены или при Reset
+class MemoryArena {
+public:
+	explicit MemoryArena(size_t block_size = DEFAULT_BLOCK_SIZE) noexcept
+		: block_size_(block_size) {
+	}
+
+	MemoryArena(const MemoryArena&) = delete;
+
+	MemoryArena& operator=(const MemoryArena&) = delete;
+
+	~MemoryArena() {
+		Reset();
+	}
+
+	void* Allocate(size_t bytes, size_t alignment) {
+		size_t aligned = (ptr_ + alignment - 1) / alignment * alignment;
+		if (blocks_ == nullptr || aligned + bytes > end_) {
+			AddBlock(bytes + alignment);
+			aligned = (ptr_ + alignment - 1) / alignment * alignment;
+		}
+		ptr_ = aligned + bytes;
+		return reinterpret_cast<void*>(aligned);
+	}
+
+	// Освобождает все блоки разом; выданные ранее указатели становятся недействительными
+	void Reset() noexcept {
+		while (blocks_ != nullptr) {
+			Block* next = blocks_->next;
+			std::free(blocks_);
+			blocks_ = next;
+		}
+		ptr_ = 0;
+		end_ = 0;
+	}
+
+private:
+	struct Block {
+		Block* next;
+	};
+
+	static const size_t DEFAULT_BLOCK_SIZE = 1u << 20u;
+
+	void AddBlock(size_t min_bytes) {
+		const size_t data_bytes = min_bytes > block_size_ ? min_bytes : block_size_;
+		Block* block = static_cast<Block*>(std::malloc(sizeof(Block) + data_bytes));
+		if (block == nullptr) {
+			throw std::bad_alloc{};
+		}
+		block->next = blocks_;
+		blocks_ = block;
+		ptr_ = reinterpret_cast<size_t>(block + 1);
+		end_ = ptr_ + data_bytes;
+	}
+
+	size_t block_size_;
+	Block* blocks_ = nullptr;
+	size_t ptr_ = 0;
+	size_t end_ = 0;
+};
+
+// Аллокатор поверх арены; Deallocate ничего не делает — память вернёт арена
+template <typename T>
+class ArenaAllocator {
+public:
+	ArenaAllocator() = default;
+
+	explicit ArenaAllocator(MemoryArena& arena) noexcept
+		: arena_(&arena) {
+	}
+
+	T* Allocate(size_t n) {
+		assert(arena_ != nullptr);
+		return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void Deallocate(T* /*buf*/, size_t /*n*/) noexcept {
+	}
+
+private:
+	MemoryArena* arena_ = nullptr;
+};
+
+// Пул: возвращённые буферы складываются в thread-local списки свободных блоков
+// по классам размеров (степени двойки) и повторно выдаются без обращения к куче
+template <typename T>
+class PoolAllocator {
+public:
+	T* Allocate(size_t n) {
+		const size_t bytes = BytesFor(n);
+		const size_t cls = SizeClass(bytes);
+		if (cls < NUM_CLASSES) {
+			FreeNode*& head = FreeLists().heads[cls];
+			if (head != nullptr) {
+				FreeNode* node = head;
+				head = node->next;
+				return reinterpret_cast<T*>(node);
+			}
+			return static_cast<T*>(operator new(size_t{1} << (cls + MIN_SHIFT)));
+		}
+		return static_cast<T*>(operator new(bytes));
+	}
+
+	void Deallocate(T* buf, size_t n) noexcept {
+		const size_t cls = SizeClass(BytesFor(n));
+		if (cls < NUM_CLASSES) {
+			FreeNode* node = reinterpret_cast<FreeNode*>(buf);
+			FreeNode*& head = FreeLists().heads[cls];
+			node->next = head;
+			head = node;
+		}
+		else {
+			operator delete(buf);
+		}
+	}
+
+private:
+	struct FreeNode {
+		FreeNode* next;
+	};
+
+	// Классы размеров: 16 байт .. 1 МБ, запросы крупнее идут напрямую в кучу
+	static const size_t MIN_SHIFT = 4;
+	static const size_t MAX_SHIFT = 20;
+	static const size_t NUM_CLASSES = MAX_SHIFT - MIN_SHIFT + 1;
+
+	struct ThreadLists {
+		FreeNode* heads[NUM_CLASSES] = {};
+
+		~ThreadLists() {
+			for (FreeNode* head : heads) {
+				while (head != nullptr) {
+					FreeNode* next = head->next;
+					operator delete(head);
+					head = next;
+				}
+			}
+		}
+	};
+
+	static size_t BytesFor(size_t n) noexcept {
+		const size_t bytes = n * sizeof(T);
+		return bytes < (size_t{1} << MIN_SHIFT) ? (size_t{1} << MIN_SHIFT) : bytes;
+	}
+
+	// Номер класса — наименьшая степень двойки, вмещающая запрос
+	static size_t SizeClass(size_t bytes) noexcept {
+		size_t shift = MIN_SHIFT;
+		while (shift <= MAX_SHIFT && (size_t{1} << shift) < bytes) {
+			++shift;
+		}
+		return shift - MIN_SHIFT;
+	}
+
+	static ThreadLists& FreeLists() {
+		thread_local ThreadLists lists;
+		return lists;
+	}
+};
+
+// Аллокатор поверх malloc/free; его Reallocate позволяет Vector расширять буфер
+// тривиально копируемых элементов на месте, когда куча может продлить блок
+template <typename T>
+struct MallocAllocator {
+	T* Allocate(size_t n) {
+		void* ptr = std::malloc(n * sizeof(T));
+		if (ptr == nullptr) {
+			throw std::bad_alloc{};
+		}
+		return static_cast<T*>(ptr);
+	}
+
+	void Deallocate(T* buf, size_t /*n*/) noexcept {
+		std::free(buf);
+	}
+
+	T* Reallocate(T* buf, size_t /*old_n*/, size_t new_n) noexcept {
+		return static_cast<T*>(std::realloc(buf, new_n * sizeof(T)));
+	}
+};
+
+// Аллокатор с гарантированным выравниванием буфера (кэш-линия, SIMD-регистры)
+template <typename T, size_t Align>
+struct AlignedAllocator {
+	static_assert((Align & (Align - 1)) == 0, "Align must be a power of two");
+	static_assert(Align >= alignof(T), "Align is weaker than natural alignment of T");
+
+	T* Allocate(size_t n) {
+		return static_cast<T*>(operator new(n * sizeof(T), std::align_val_t{Align}));
+	}
+
+	void Deallocate(T* buf, size_t /*n*/) noexcept {
+		operator delete(buf, std::align_val_t{Align});
+	}
+};
+
+// Вектор с перевыравненным буфером: гарантия сохраняется при всех реаллокациях,
+// поэтому SIMD-ядрам не нужны peel-циклы для невыровненного начала данных
+template <typename T, size_t Align>
+using AlignedVector = Vector<T, AlignedAllocator<T, Align>>;
+
+// Аллокатор для многогигабайтных массивов: начиная с HUGE_THRESHOLD байт память
+// берётся напрямую у mmap с подсказкой MADV_HUGEPAGE, мелкие запросы идут в operator new
+template <typename T>
+struct HugePageAllocator {
+	// 2 МБ — размер большой страницы x86-64
+	static const size_t HUGE_PAGE_SIZE = size_t{2} << 20u;
+	static const size_t HUGE_THRESHOLD = HUGE_PAGE_SIZE;
+
+	T* Allocate(size_t n) {
+		const size_t bytes = n * sizeof(T);
+#if defined(__linux__)
+		if (bytes >= HUGE_THRESHOLD) {
+			const size_t rounded = RoundToHugePages(bytes);
+			void* ptr = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (ptr == MAP_FAILED) {
+				throw std::bad_alloc{};
+			}
+			madvise(ptr, rounded, MADV_HUGEPAGE);
+			return static_cast<T*>(ptr);
+		}
+#endif
+		return static_cast<T*>(operator new(bytes));
+	}
+
+	void Deallocate(T* buf, size_t n) noexcept {
+		const size_t bytes = n * sizeof(T);
+#if defined(__linux__)
+		if (bytes >= HUGE_THRESHOLD) {
+			munmap(buf, RoundToHugePages(bytes));
+			return;
+		}
+#endif
+		operator delete(buf);
+	}
+
+private:
+	static size_t RoundToHugePages(size_t bytes) noexcept {
+		return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+	}
+};
+
+// Политика размещения страниц по NUMA-узлам
+enum class NumaPlacement {
+	// Страница достаётся узлу потока, первым её тронувшего; в паре с
+	// VECTOR_PARALLEL_BULK данные сами распределяются по узлам рабочих потоков
+	FIRST_TOUCH,
+	// Страницы чередуются по всем доступным узлам — ровная полоса пропускания
+	// для векторов, которые сканируют потоки с обоих сокетов
+	INTERLEAVE,
+	// Все страницы привязываются к одному узлу
+	BIND,
+};
+
+// NUMA-аллокатор: крупные буферы берутся у mmap и привязываются к узлам через
+// mbind (прямой syscall — без зависимости от libnuma). Политика хранится
+// в самом аллокаторе и потому переживает все реаллокации Reserve. На машинах
+// без NUMA (и не на Linux) mbind — необязательная подсказка, аллокатор
+// работает как обычный mmap/new
+template <typename T>
+class NumaAllocator {
+public:
+	NumaAllocator() = default;
+
+	explicit NumaAllocator(NumaPlacement placement, int node = 0) noexcept
+		: placement_(placement)
+		, node_(node) {
+	}
+
+	T* Allocate(size_t n) {
+		const size_t bytes = n * sizeof(T);
+#if defined(__linux__)
+		if (bytes >= MMAP_THRESHOLD) {
+			const size_t rounded = RoundToPages(bytes);
+			void* ptr = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (ptr == MAP_FAILED) {
+				throw std::bad_alloc{};
+			}
+			ApplyPolicy(ptr, rounded);
+			return static_cast<T*>(ptr);
+		}
+#endif
+		return static_cast<T*>(operator new(bytes));
+	}
+
+	void Deallocate(T* buf, size_t n) noexcept {
+		const size_t bytes = n * sizeof(T);
+#if defined(__linux__)
+		if (bytes >= MMAP_THRESHOLD) {
+			munmap(buf, RoundToPages(bytes));
+			return;
+		}
+#endif
+		operator delete(buf);
+	}
+
+	NumaPlacement Placement() const noexcept {
+		return placement_;
+	}
+
+private:
+	static const size_t PAGE_SIZE = 4096;
+	// Мелкие буферы не стоят отдельных страниц — они идут в обычную кучу
+	static const size_t MMAP_THRESHOLD = size_t{1} << 20u;
+
+	static size_t RoundToPages(size_t bytes) noexcept {
+		return (bytes + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+	}
+
+#if defined(__linux__)
+	// Номера режимов mbind из include/uapi/linux/mempolicy.h
+	static const int MPOL_BIND_MODE = 2;
+	static const int MPOL_INTERLEAVE_MODE = 3;
+
+	void ApplyPolicy(void* ptr, size_t bytes) const noexcept {
+		if (placement_ == NumaPlacement::FIRST_TOUCH) {
+			return;
+		}
+		unsigned long nodemask;
+		int mode;
+		if (placement_ == NumaPlacement::BIND) {
+			mode = MPOL_BIND_MODE;
+			nodemask = 1ul << static_cast<unsigned>(node_);
+		}
+		else {
+			mode = MPOL_INTERLEAVE_MODE;
+			nodemask = AllowedNodes();
+		}
+		// Размещение — подсказка планировщику памяти: отказ (например, на
+		// одноузловой машине) не мешает использовать буфер
+		syscall(SYS_mbind, ptr, bytes, mode, &nodemask, sizeof(nodemask) * 8, 0);
+	}
+
+	// Маска узлов, доступных процессу (get_mempolicy с MPOL_F_MEMS_ALLOWED)
+	static unsigned long AllowedNodes() noexcept {
+		const int MEMS_ALLOWED_FLAG = 1 << 2;
+		unsigned long mask = 0;
+		if (syscall(SYS_get_mempolicy, nullptr, &mask, sizeof(mask) * 8, nullptr, MEMS_ALLOWED_FLAG) != 0
+			|| mask == 0) {
+			mask = 1;
+		}
+		return mask;
+	}
+#endif
+
+	NumaPlacement placement_ = NumaPlacement::FIRST_TOUCH;
+	int node_ = 0;
+};
@@ -0,0 +1,248 @@
+﻿#include "vector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+    // Количество повторов; в отчёт идёт медиана, чтобы отсечь выбросы планировщика
+    constexpr int NUM_REPS = 5;
+
+    uint64_t ReadCycles() {
+#if defined(__x86_64__) || defined(_M_X64)
+        return __builtin_ia32_rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    struct RunResult {
+        double millis = 0.0;
+        uint64_t cycles = 0;
+    };
+
+    // Один прогрев, затем NUM_REPS замеров; медиана по времени
+    template <typename Fn>
+    void RunBench(std::string_view name, size_t num_ops, Fn fn) {
+        fn();
+        std::vector<RunResult> results;
+        for (int rep = 0; rep < NUM_REPS; ++rep) {
+            const auto start_cycles = ReadCycles();
+            const auto start = std::chrono::steady_clock::now();
+            fn();
+            const auto stop = std::chrono::steady_clock::now();
+            const auto stop_cycles = ReadCycles();
+            RunResult result;
+            result.millis = std::chrono::duration<double, std::milli>(stop - start).count();
+            result.cycles = stop_cycles - start_cycles;
+            results.push_back(result);
+        }
+        std::sort(results.begin(), results.end(), [](const RunResult& lhs, const RunResult& rhs) {
+            return lhs.millis < rhs.millis;
+            });
+        const RunResult& median = results[results.size() / 2];
+        const double mops = static_cast<double>(num_ops) / 1e6 / (median.millis / 1e3);
+        std::cout << std::left << std::setw(44) << name << std::right << std::fixed
+            << std::setprecision(3) << std::setw(12) << median.millis << " ms"
+            << std::setprecision(1) << std::setw(12) << mops << " Mops/s";
+        if (median.cycles != 0) {
+            std::cout << std::setw(14) << median.cycles / num_ops << " cyc/op";
+        }
+        std::cout << std::endl;
+    }
+
+    // Тип только с копированием: проверяет ветки uninitialized_copy_n
+    struct CopyOnly {
+        CopyOnly() = default;
+        explicit CopyOnly(int id) : id(id) {}
+        // Пользовательский копирующий конструктор подавляет генерацию перемещающих операций
+        CopyOnly(const CopyOnly& other) : id(other.id) {}
+        CopyOnly& operator=(const CopyOnly& other) {
+            id = other.id;
+            return *this;
+        }
+        int id = 0;
+        double payload[3] = {};
+    };
+
+    template <typename T>
+    T MakeValue(size_t i);
+
+    template <>
+    int MakeValue<int>(size_t i) {
+        return static_cast<int>(i);
+    }
+
+    template <>
+    std::string MakeValue<std::string>(size_t i) {
+        // Достаточно длинная строка, чтобы выйти за SSO
+        return "value-with-heap-allocation-" + std::to_string(i);
+    }
+
+    template <>
+    CopyOnly MakeValue<CopyOnly>(size_t i) {
+        return CopyOnly{ static_cast<int>(i) };
+    }
+
+    // Адаптеры, скрывающие разницу в именах методов Vector и std::vector
+    template <typename T>
+    void Add(Vector<T>& v, T value) {
+        v.PushBack(std::move(value));
+    }
+
+    template <typename T>
+    void Add(std::vector<T>& v, T value) {
+        v.push_back(std::move(value));
+    }
+
+    void Add(Vector<CopyOnly>& v, const CopyOnly& value) {
+        v.PushBack(value);
+    }
+
+    void Add(std::vector<CopyOnly>& v, const CopyOnly& value) {
+        v.push_back(value);
+    }
+
+    template <typename T>
+    void ReserveIn(Vector<T>& v, size_t n) {
+        v.Reserve(n);
+    }
+
+    template <typename T>
+    void ReserveIn(std::vector<T>& v, size_t n) {
+        v.reserve(n);
+    }
+
+    template <typename T>
+    void InsertAt(Vector<T>& v, size_t index, T value) {
+        v.Insert(v.cbegin() + index, std::move(value));
+    }
+
+    template <typename T>
+    void InsertAt(std::vector<T>& v, size_t index, T value) {
+        v.insert(v.cbegin() + index, std::move(value));
+    }
+
+    template <typename T>
+    void EraseAt(Vector<T>& v, size_t index) {
+        v.Erase(v.cbegin() + index);
+    }
+
+    template <typename T>
+    void EraseAt(std::vector<T>& v, size_t index) {
+        v.erase(v.cbegin() + index);
+    }
+
+    template <typename Container, typename T>
+    void BenchPushBackGrowth(std::string_view name, size_t n) {
+        RunBench(name, n, [n] {
+            Container v;
+            for (size_t i = 0; i < n; ++i) {
+                Add(v, MakeValue<T>(i));
+            }
+            });
+    }
+
+    template <typename Container, typename T>
+    void BenchReserveFill(std::string_view name, size_t n) {
+        RunBench(name, n, [n] {
+            Container v;
+            ReserveIn(v, n);
+            for (size_t i = 0; i < n; ++i) {
+                Add(v, MakeValue<T>(i));
+            }
+            });
+    }
+
+    template <typename Container, typename T>
+    void BenchInsert(std::string_view name, size_t base_size, size_t inserts, bool front) {
+        RunBench(name, inserts, [=] {
+            Container v;
+            ReserveIn(v, base_size + inserts);
+            for (size_t i = 0; i < base_size; ++i) {
+                Add(v, MakeValue<T>(i));
+            }
+            for (size_t i = 0; i < inserts; ++i) {
+                InsertAt(v, front ? 0 : (base_size + i) / 2, MakeValue<T>(i));
+            }
+            });
+    }
+
+    template <typename Container, typename T>
+    void BenchErase(std::string_view name, size_t base_size, size_t erases) {
+        RunBench(name, erases, [=] {
+            Container v;
+            for (size_t i = 0; i < base_size; ++i) {
+                Add(v, MakeValue<T>(i));
+            }
+            for (size_t i = 0; i < erases; ++i) {
+                EraseAt(v, (base_size - i) / 2);
+            }
+            });
+    }
+
+    template <typename Container, typename T>
+    void BenchCopyAssign(std::string_view name, size_t n, size_t reps) {
+        Container src;
+        for (size_t i = 0; i < n; ++i) {
+            Add(src, MakeValue<T>(i));
+        }
+        RunBench(name, n * reps, [&src, reps] {
+            Container dst;
+            for (size_t i = 0; i < reps; ++i) {
+                dst = src;
+            }
+            });
+    }
+
+    template <typename Container, typename T>
+    void BenchMove(std::string_view name, size_t reps) {
+        Container src;
+        for (size_t i = 0; i < 1000; ++i) {
+            Add(src, MakeValue<T>(i));
+        }
+        RunBench(name, reps, [&src, reps] {
+            Container a = std::move(src);
+            Container b;
+            for (size_t i = 0; i < reps; ++i) {
+                b = std::move(a);
+                a = std::move(b);
+            }
+            src = std::move(a);
+            });
+    }
+
+    template <typename T>
+    void BenchType(std::string_view type_name, size_t n, size_t edit_ops) {
+        using Ours = Vector<T>;
+        using Std = std::vector<T>;
+        const std::string prefix = std::string{ type_name } + ": ";
+        BenchPushBackGrowth<Ours, T>(prefix + "PushBack growth [Vector]", n);
+        BenchPushBackGrowth<Std, T>(prefix + "PushBack growth [std::vector]", n);
+        BenchReserveFill<Ours, T>(prefix + "Reserve + fill [Vector]", n);
+        BenchReserveFill<Std, T>(prefix + "Reserve + fill [std::vector]", n);
+        BenchInsert<Ours, T>(prefix + "Insert front [Vector]", edit_ops, edit_ops, true);
+        BenchInsert<Std, T>(prefix + "Insert front [std::vector]", edit_ops, edit_ops, true);
+        BenchInsert<Ours, T>(prefix + "Insert middle [Vector]", edit_ops, edit_ops, false);
+        BenchInsert<Std, T>(prefix + "Insert middle [std::vector]", edit_ops, edit_ops, false);
+        BenchErase<Ours, T>(prefix + "Erase middle [Vector]", edit_ops * 2, edit_ops);
+        BenchErase<Std, T>(prefix + "Erase middle [std::vector]", edit_ops * 2, edit_ops);
+        BenchCopyAssign<Ours, T>(prefix + "Copy assign [Vector]", n / 10, 10);
+        BenchCopyAssign<Std, T>(prefix + "Copy assign [std::vector]", n / 10, 10);
+        BenchMove<Ours, T>(prefix + "Move assign [Vector]", n);
+        BenchMove<Std, T>(prefix + "Move assign [std::vector]", n);
+    }
+
+}  // namespace
+
+int main() {
+    BenchType<int>("int", 4'000'000, 20'000);
+    BenchType<std::string>("string", 400'000, 5'000);
+    BenchType<CopyOnly>("copy-only", 1'000'000, 10'000);
+}
@@ -0,0 +1,606 @@
+﻿#pragma once
+#include "vector.h"
+
+#include <bit>
+#include <cstdint>
+
+// Упакованные движки хранения поверх Vector<uint64_t>:
+//  - BitVector — бит на элемент вместо байта в Vector<uint8_t>: в 8 раз меньше
+//    памяти и трафика при сканировании, популяция и поиск идут по целым словам
+//    (std::popcount / countr_zero компилируются в POPCNT/TZCNT);
+//  - PackedVector<BITS> — целые фиксированной ширины 2..16 бит, уложенные
+//    вплотную, со сквозной нумерацией и массовым кодированием/декодированием.
+// Оба держат инвариант: биты выше логического размера в последнем слове нулевые,
+// поэтому пословные операции не требуют маскирования на каждом шаге
+class BitVector {
+	class Reference;
+
+	template <bool IS_CONST>
+	class BasicIterator;
+
+public:
+	using iterator = BasicIterator<false>;
+	using const_iterator = BasicIterator<true>;
+
+	// Индекс-признак «не найдено» для FindNext
+	static constexpr size_t NPOS = static_cast<size_t>(-1);
+
+	BitVector() = default;
+
+	explicit BitVector(size_t size, bool value = false) {
+		Resize(size, value);
+	}
+
+	size_t Size() const noexcept {
+		return size_;
+	}
+
+	size_t Capacity() const noexcept {
+		return words_.Capacity() * 64u;
+	}
+
+	void Reserve(size_t new_capacity) {
+		words_.Reserve((new_capacity + 63u) / 64u);
+	}
+
+	void PushBack(bool value) {
+		if (size_ == words_.Size() * 64u) {
+			words_.PushBack(uint64_t{0});
+		}
+		if (value) {
+			words_[size_ / 64u] |= uint64_t{1} << (size_ % 64u);
+		}
+		++size_;
+	}
+
+	void PopBack() noexcept {
+		--size_;
+		words_[size_ / 64u] &= ~(uint64_t{1} << (size_ % 64u));
+	}
+
+	void Resize(size_t new_size, bool value = false) {
+		if (new_size < size_) {
+			words_.Resize((new_size + 63u) / 64u);
+			size_ = new_size;
+			ClearTail();
+			return;
+		}
+		const size_t old_size = size_;
+		while (words_.Size() * 64u < new_size) {
+			words_.PushBack(uint64_t{0});
+		}
+		size_ = new_size;
+		if (value) {
+			SetRange(old_size, new_size);
+		}
+	}
+
+	bool operator[](size_t index) const noexcept {
+		assert(index < size_);
+		return (words_[index / 64u] >> (index % 64u)) & 1u;
+	}
+
+	Reference operator[](size_t index) noexcept {
+		assert(index < size_);
+		return Reference(&words_[index / 64u], uint64_t{1} << (index % 64u));
+	}
+
+	iterator begin() noexcept {
+		return iterator(this, 0);
+	}
+
+	iterator end() noexcept {
+		return iterator(this, size_);
+	}
+
+	const_iterator begin() const noexcept {
+		return const_iterator(this, 0);
+	}
+
+	const_iterator end() const noexcept {
+		return const_iterator(this, size_);
+	}
+
+	const_iterator cbegin() const noexcept {
+		return begin();
+	}
+
+	const_iterator cend() const noexcept {
+		return end();
+	}
+
+	// Число установленных битов; пословный POPCNT, хвост за инвариантом чист
+	size_t CountOnes() const noexcept {
+		size_t total = 0;
+		for (size_t word = 0; word < words_.Size(); ++word) {
+			total += static_cast<size_t>(std::popcount(words_[word]));
+		}
+		return total;
+	}
+
+	// Индекс первого бита со значением value, начиная с from; NPOS, если нет.
+	// Свободные от совпадений слова пропускаются целиком
+	size_t FindNext(bool value, size_t from = 0) const noexcept {
+		size_t word = from / 64u;
+		uint64_t mask = ~uint64_t{0} << (from % 64u);
+		for (; word < words_.Size(); ++word, mask = ~uint64_t{0}) {
+			uint64_t bits = value ? words_[word] : ~words_[word];
+			bits &= mask;
+			if (bits != 0) {
+				const size_t index = word * 64u + static_cast<size_t>(std::countr_zero(bits));
+				return index < size_ ? index : NPOS;
+			}
+		}
+		return NPOS;
+	}
+
+	void Swap(BitVector& other) noexcept {
+		words_.Swap(other.words_);
+		std::swap(size_, other.size_);
+	}
+
+private:
+	// Прокси-ссылка на бит: читается как bool, присваивание правит слово по маске
+	class Reference {
+		friend class BitVector;
+
+	public:
+		operator bool() const noexcept {
+			return (*word_ & mask_) != 0;
+		}
+
+		Reference& operator=(bool value) noexcept {
+			if (value) {
+				*word_ |= mask_;
+			}
+			else {
+				*word_ &= ~mask_;
+			}
+			return *this;
+		}
+
+		Reference& operator=(const Reference& rhs) noexcept {
+			return *this = static_cast<bool>(rhs);
+		}
+
+		void Flip() noexcept {
+			*word_ ^= mask_;
+		}
+
+	private:
+		Reference(uint64_t* word, uint64_t mask) noexcept
+			: word_(word)
+			, mask_(mask) {
+		}
+
+		uint64_t* word_;
+		uint64_t mask_;
+	};
+
+	template <bool IS_CONST>
+	class BasicIterator {
+		friend class BitVector;
+
+		template <bool OTHER_CONST>
+		friend class BasicIterator;
+
+		using Owner = std::conditional_t<IS_CONST, const BitVector, BitVector>;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = bool;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = std::conditional_t<IS_CONST, bool, BitVector::Reference>;
+
+		BasicIterator() = default;
+
+		template <bool C = IS_CONST, typename = std::enable_if_t<C>>
+		BasicIterator(const BasicIterator<false>& other) noexcept
+			: owner_(other.owner_)
+			, index_(other.index_) {
+		}
+
+		reference operator*() const noexcept {
+			return (*owner_)[index_];
+		}
+
+		reference operator[](difference_type offset) const noexcept {
+			return (*owner_)[index_ + static_cast<size_t>(offset)];
+		}
+
+		BasicIterator& operator++() noexcept {
+			++index_;
+			return *this;
+		}
+
+		BasicIterator operator++(int) noexcept {
+			BasicIterator copy(*this);
+			++index_;
+			return copy;
+		}
+
+		BasicIterator& operator--() noexcept {
+			--index_;
+			return *this;
+		}
+
+		BasicIterator operator--(int) noexcept {
+			BasicIterator copy(*this);
+			--index_;
+			return copy;
+		}
+
+		BasicIterator& operator+=(difference_type offset) noexcept {
+			index_ += static_cast<size_t>(offset);
+			return *this;
+		}
+
+		BasicIterator& operator-=(difference_type offset) noexcept {
+			index_ -= static_cast<size_t>(offset);
+			return *this;
+		}
+
+		friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+			return it += offset;
+		}
+
+		friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+			return it += offset;
+		}
+
+		friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+			return it -= offset;
+		}
+
+		template <bool OTHER_CONST>
+		difference_type operator-(const BasicIterator<OTHER_CONST>& rhs) const noexcept {
+			return static_cast<difference_type>(index_) - static_cast<difference_type>(rhs.index_);
+		}
+
+		template <bool OTHER_CONST>
+		bool operator==(const BasicIterator<OTHER_CONST>& rhs) const noexcept {
+			return index_ == rhs.index_;
+		}
+
+		template <bool OTHER_CONST>
+		bool operator!=(const BasicIterator<OTHER_CONST>& rhs) const noexcept {
+			return index_ != rhs.index_;
+		}
+
+		template <bool OTHER_CONST>
+		bool operator<(const BasicIterator<OTHER_CONST>& rhs) const noexcept {
+			return index_ < rhs.index_;
+		}
+
+		template <bool OTHER_CONST>
+		bool operator<=(const BasicIterator<OTHER_CONST>& rhs) const noexcept {
+			return index_ <= rhs.index_;
+		}
+
+		template <bool OTHER_CONST>
+		bool operator>(const BasicIterator<OTHER_CONST>& rhs) const noexcept {
+			return index_ > rhs.index_;
+		}
+
+		template <bool OTHER_CONST>
+		bool operator>=(const BasicIterator<OTHER_CONST>& rhs) const noexcept {
+			return index_ >= rhs.index_;
+		}
+
+	private:
+		BasicIterator(Owner* owner, size_t index) noexcept
+			: owner_(owner)
+			, index_(index) {
+		}
+
+		Owner* owner_ = nullptr;
+		size_t index_ = 0;
+	};
+
+	// Устанавливает биты [from, to); середина заливается целыми словами
+	void SetRange(size_t from, size_t to) noexcept {
+		for (; from < to && from % 64u != 0; ++from) {
+			words_[from / 64u] |= uint64_t{1} << (from % 64u);
+		}
+		for (; from + 64u <= to; from += 64u) {
+			words_[from / 64u] = ~uint64_t{0};
+		}
+		for (; from < to; ++from) {
+			words_[from / 64u] |= uint64_t{1} << (from % 64u);
+		}
+	}
+
+	// Обнуляет биты последнего слова выше size_ — опора пословных операций
+	void ClearTail() noexcept {
+		if (size_ % 64u != 0) {
+			words_[size_ / 64u] &= (uint64_t{1} << (size_ % 64u)) - 1u;
+		}
+	}
+
+	Vector<uint64_t> words_;
+	size_t size_ = 0;
+};
+
+// Вектор целых фиксированной ширины BITS (2..16 бит), уложенных вплотную:
+// элемент может пересекать границу слова, чтение/запись собирают его из двух
+// соседних слов. Для однобитовых значений есть BitVector
+template <size_t BITS>
+class PackedVector {
+	static_assert(BITS >= 2 && BITS <= 16, "PackedVector supports widths of 2..16 bits");
+
+	class Reference;
+
+	template <bool IS_CONST>
+	class BasicIterator;
+
+public:
+	using value_type = uint64_t;
+	using iterator = BasicIterator<false>;
+	using const_iterator = BasicIterator<true>;
+
+	// Наибольшее представимое значение; всё записываемое обрезается этой маской
+	static constexpr uint64_t MAX_VALUE = (uint64_t{1} << BITS) - 1u;
+
+	PackedVector() = default;
+
+	size_t Size() const noexcept {
+		return size_;
+	}
+
+	size_t Capacity() const noexcept {
+		return words_.Capacity() * 64u / BITS;
+	}
+
+	void Reserve(size_t new_capacity) {
+		words_.Reserve((new_capacity * BITS + 63u) / 64u);
+	}
+
+	void PushBack(uint64_t value) {
+		const size_t bit_end = (size_ + 1u) * BITS;
+		while (words_.Size() * 64u < bit_end) {
+			words_.PushBack(uint64_t{0});
+		}
+		++size_;
+		Set(size_ - 1u, value);
+	}
+
+	void PopBack() noexcept {
+		Set(size_ - 1u, 0);
+		--size_;
+	}
+
+	uint64_t operator[](size_t index) const noexcept {
+		assert(index < size_);
+		return Get(index);
+	}
+
+	Reference operator[](size_t index) noexcept {
+		assert(index < size_);
+		return Reference(this, index);
+	}
+
+	iterator begin() noexcept {
+		return iterator(this, 0);
+	}
+
+	iterator end() noexcept {
+		return iterator(this, size_);
+	}
+
+	const_iterator begin() const noexcept {
+		return const_iterator(this, 0);
+	}
+
+	const_iterator end() const noexcept {
+		return const_iterator(this, size_);
+	}
+
+	const_iterator cbegin() const noexcept {
+		return begin();
+	}
+
+	const_iterator cend() const noexcept {
+		return end();
+	}
+
+	// Массовое кодирование: контейнер замещается упакованной копией values
+	template <typename U>
+	void Encode(const U* values, size_t count) {
+		words_.Assign((count * BITS + 63u) / 64u, uint64_t{0});
+		size_ = count;
+		for (size_t i = 0; i < count; ++i) {
+			Set(i, static_cast<uint64_t>(values[i]));
+		}
+	}
+
+	// Массовое декодирование count элементов, начиная с from, в обычный массив
+	template <typename U>
+	void Decode(U* out, size_t from, size_t count) const noexcept {
+		assert(from + count <= size_);
+		for (size_t i = 0; i < count; ++i) {
+			out[i] = static_cast<U>(Get(from + i));
+		}
+	}
+
+	void Swap(PackedVector& other) noexcept {
+		words_.Swap(other.words_);
+		std::swap(size_, other.size_);
+	}
+
+private:
+	class Reference {
+		friend class PackedVector;
+
+	public:
+		operator uint64_t() const noexcept {
+			return owner_->Get(index_);
+		}
+
+		Reference& operator=(uint64_t value) noexcept {
+			owner_->Set(index_, value);
+			return *this;
+		}
+
+		Reference& operator=(const Reference& rhs) noexcept {
+			return *this = static_cast<uint64_t>(rhs);
+		}
+
+	private:
+		Reference(PackedVector* owner, size_t index) noexcept
+			: owner_(owner)
+			, index_(index) {
+		}
+
+		PackedVector* owner_;
+		size_t index_;
+	};
+
+	template <bool IS_CONST>
+	class BasicIterator {
+		friend class PackedVector;
+
+		template <bool OTHER_CONST>
+		friend class BasicIterator;
+
+		using Owner = std::conditional_t<IS_CONST, const PackedVector, PackedVector>;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = uint64_t;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = std::conditional_t<IS_CONST, uint64_t, PackedVector::Reference>;
+
+		BasicIterator() = default;
+
+		template <bool C = IS_CONST, typename = std::enable_if_t<C>>
+		BasicIterator(const BasicIterator<false>& other) noexcept
+			: owner_(other.owner_)
+			, index_(other.index_) {
+		}
+
+		reference operator*() const noexcept {
+			return (*owner_)[index_];
+		}
+
+		reference operator[](difference_type offset) const noexcept {
+			return (*owner_)[index_ + static_cast<size_t>(offset)];
+		}
+
+		BasicIterator& operator++() noexcept {
+			++index_;
+			return *this;
+		}
+
+		BasicIterator operator++(int) noexcept {
+			BasicIterator copy(*this);
+			++index_;
+			return copy;
+		}
+
+		BasicIterator& operator--() noexcept {
+			--index_;
+			return *this;
+		}
+
+		BasicIterator operator--(int) noexcept {
+			BasicIterator copy(*this);
+			--index_;
+			return copy;
+		}
+
+		BasicIterator& operator+=(difference_type offset) noexcept {
+			index_ += static_cast<size_t>(offset);
+			return *this;
+		}
+
+		BasicIterator& operator-=(difference_type offset) noexcept {
+			index_ -= static_cast<size_t>(offset);
+			return *this;
+		}
+
+		friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+			return it += offset;
+		}
+
+		friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+			return it += offset;
+		}
+
+		friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+			return it -= offset;
+		}
+
+		template <bool OTHER_CONST>
+		difference_type operator-(const BasicIterator<OTHER_CONST>& rhs) const noexcept {
+			return static_cast<difference_type>(index_) - static_cast<difference_type>(rhs.index_);
+		}
+
+		template <bool OTHER_CONST>
+		bool operator==(const BasicIterator<OTHER_CONST>& rhs) const noexcept {
+			return index_ == rhs.index_;
+		}
+
+		template <bool OTHER_CONST>
+		bool operator!=(const BasicIterator<OTHER_CONST>& rhs) const noexcept {
+			return index_ != rhs.index_;
+		}
+
+		template <bool OTHER_CONST>
+		bool operator<(const BasicIterator<OTHER_CONST>& rhs) const noexcept {
+			return index_ < rhs.index_;
+		}
+
+		template <bool OTHER_CONST>
+		bool operator<=(const BasicIterator<OTHER_CONST>& rhs) const noexcept {
+			return index_ <= rhs.index_;
+		}
+
+		template <bool OTHER_CONST>
+		bool operator>(const BasicIterator<OTHER_CONST>& rhs) const noexcept {
+			return index_ > rhs.index_;
+		}
+
+		template <bool OTHER_CONST>
+		bool operator>=(const BasicIterator<OTHER_CONST>& rhs) const noexcept {
+			return index_ >= rhs.index_;
+		}
+
+	private:
+		BasicIterator(Owner* owner, size_t index) noexcept
+			: owner_(owner)
+			, index_(index) {
+		}
+
+		Owner* owner_ = nullptr;
+		size_t index_ = 0;
+	};
+
+	uint64_t Get(size_t index) const noexcept {
+		const size_t bit = index * BITS;
+		const size_t word = bit / 64u;
+		const size_t shift = bit % 64u;
+		uint64_t value = words_[word] >> shift;
+		if (shift + BITS > 64u) {
+			value |= words_[word + 1u] << (64u - shift);
+		}
+		return value & MAX_VALUE;
+	}
+
+	void Set(size_t index, uint64_t value) noexcept {
+		value &= MAX_VALUE;
+		const size_t bit = index * BITS;
+		const size_t word = bit / 64u;
+		const size_t shift = bit % 64u;
+		words_[word] = (words_[word] & ~(MAX_VALUE << shift)) | (value << shift);
+		if (shift + BITS > 64u) {
+			const size_t spill = shift + BITS - 64u;
+			const uint64_t spill_mask = (uint64_t{1} << spill) - 1u;
+			words_[word + 1u] = (words_[word + 1u] & ~spill_mask) | (value >> (64u - shift));
+		}
+	}
+
+	Vector<uint64_t> words_;
+	size_t size_ = 0;
+};
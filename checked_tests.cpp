@@ -0,0 +1,186 @@
+#define VECTOR_CHECKED
+#include "vector.h"
+
+#include "allocators.h"
+#include "bit_vector.h"
+#include "concurrent_vector.h"
+#include "fixed_vector.h"
+#include "mapped_vector.h"
+#include "segmented_vector.h"
+#include "shared_vector.h"
+#include "small_vector.h"
+#include "soa_vector.h"
+#include "sorted_vector.h"
+#include "stable_vector.h"
+#include "vector_io.h"
+#include "vector_trace.h"
+
+#include <algorithm>
+#include <cassert>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+// Соседние заголовки обязаны собираться поверх проверяемого Vector —
+// явные инстанцирования ловят любую завязку на iterator == T*
+template class Vector<int>;
+template class SortedVector<int>;
+template class SegmentedVector<int>;
+template class StableVector<int>;
+template class SharedVector<int>;
+template class ConcurrentVector<int>;
+template class SmallVector<int, 8>;
+template class FixedVector<int, 8>;
+template class PackedVector<12>;
+template class SoaVector<int, double>;
+
+using namespace std::literals;
+
+namespace {
+
+// Обработчик для тестов: превращает нарушение в исключение вместо abort
+void ThrowingHandler(const char* what) {
+    throw std::runtime_error(what);
+}
+
+bool Violates(void (*action)()) {
+    vector_checked_violation_handler = &ThrowingHandler;
+    bool caught = false;
+    try {
+        action();
+    }
+    catch (const std::runtime_error&) {
+        caught = true;
+    }
+    vector_checked_violation_handler = nullptr;
+    return caught;
+}
+
+// Аллокатор, проверяющий, что возвращаемый буфер затёрт байтом 0xDD
+template <typename T>
+struct PoisonCheckingAllocator {
+    inline static bool poison_seen = false;
+
+    T* Allocate(size_t count) {
+        return NewDeleteAllocator<T>{}.Allocate(count);
+    }
+
+    void Deallocate(T* buf, size_t count) noexcept {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(buf);
+        poison_seen = std::all_of(bytes, bytes + count * sizeof(T), [](unsigned char b) {
+            return b == 0xDD;
+            });
+        NewDeleteAllocator<T>{}.Deallocate(buf, count);
+    }
+};
+
+}  // namespace
+
+// Жёсткая проверка границ operator[] не зависит от NDEBUG
+void TestIndexFence() {
+    assert(Violates([] {
+        Vector<int> v(3);
+        v[3] = 1;
+        }));
+    assert(Violates([] {
+        const Vector<int> v;
+        (void)v[0];
+        }));
+    Vector<int> v(3);
+    v[2] = 42;
+    assert(v[2] == 42);
+}
+
+// Итератор, переживший реаллокацию, ловится при разыменовании
+void TestStaleIterator() {
+    assert(Violates([] {
+        Vector<std::string> v;
+        v.PushBack("first"s);
+        auto it = v.begin();
+        for (int i = 0; i < 100; ++i) {
+            v.EmplaceBack("filler"s);
+        }
+        (void)*it;
+        }));
+    assert(Violates([] {
+        Vector<int> v(4);
+        auto it = v.begin() + 1;
+        v.Reserve(1000);
+        (void)*it;
+        }));
+    // Без реаллокации итераторы остаются действительными
+    Vector<int> v;
+    v.Reserve(16);
+    v.PushBack(1);
+    auto it = v.begin();
+    v.PushBack(2);
+    assert(*it == 1);
+}
+
+// Свежие итераторы после модификаций работают как обычные random access
+void TestIteratorsUsable() {
+    Vector<std::string> v;
+    for (int i = 0; i < 10; ++i) {
+        v.EmplaceBack(std::to_string(i));
+    }
+    auto found = std::find(v.begin(), v.end(), "7"s);
+    assert(found != v.end() && found - v.begin() == 7);
+    auto pos = v.Insert(v.cbegin() + 2, "ins"s);
+    assert(*pos == "ins"s && pos - v.begin() == 2);
+    pos = v.Erase(v.cbegin() + 2);
+    assert(*pos == "2"s && v.Size() == 10);
+    assert(v.begin() == v.cbegin() && v.end() == v.cend());
+}
+
+// Освобождаемая память затирается до возврата аллокатору
+void TestPoisonFill() {
+    PoisonCheckingAllocator<int>::poison_seen = false;
+    {
+        Vector<int, PoisonCheckingAllocator<int>> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+        }
+        v.Reserve(1000);
+    }
+    assert(PoisonCheckingAllocator<int>::poison_seen);
+}
+
+// Члены-шаблоны не покрываются явным инстанцированием — дёргаем их руками
+void TestSiblingComposition() {
+    SortedVector<int> sv;
+    for (int i = 9; i >= 0; --i) {
+        sv.Insert(i);
+    }
+    assert(sv.Contains(7) && !sv.Contains(10));
+    assert(std::is_sorted(sv.begin(), sv.end()));
+
+    SoaVector<int, double> soa;
+    soa.EmplaceBack(1, 2.0);
+    soa.EmplaceBack(3, 4.0);
+    assert(*soa.LaneData<0>() == 1 && soa.LaneData<1>()[1] == 4.0);
+
+    Vector<int> src;
+    for (int i = 0; i < 5; ++i) {
+        src.PushBack(i);
+    }
+    std::stringstream stream;
+    WriteTo(src, stream);
+    Vector<int> dst;
+    ReadFrom(dst, stream);
+    assert(dst.Size() == 5 && dst[4] == 4);
+
+    Trace trace;
+    trace.Note(TraceOp::APPEND, 3);
+    trace.Note(TraceOp::APPEND, 2);
+    trace.Note(TraceOp::ERASE, 0);
+    assert(trace.Size() == 2 && trace.begin()->arg == 5);
+}
+
+int main() {
+    TestIndexFence();
+    TestStaleIterator();
+    TestIteratorsUsable();
+    TestPoisonFill();
+    TestSiblingComposition();
+    return 0;
+}
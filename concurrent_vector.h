@@ -0,0 +1,136 @@
+﻿#pragma once
+#include "vector.h"
+
+#include <atomic>
+
+// Вектор для многопоточного наполнения: PushBack без блокировок из любого числа
+// потоков-продюсеров. Хранилище сегментировано — уже выданные сегменты никогда
+// не перемещаются, поэтому резервирование места сводится к одному fetch_add.
+// Ёмкость сегмента k равна BASE << k, так что 48 сегментов покрывают весь size_t.
+//
+// Протокол использования — «сначала пишем, потом читаем»: фаза записи из многих
+// потоков, затем синхронизация (join продюсеров) и Freeze(), отдающий обычный
+// непрерывный Vector<T> для фазы чтения. Во время записи Size() — оценка снизу:
+// место под элемент резервируется раньше, чем завершится его конструктор.
+// Конструктор T не должен бросать исключений — откат занятого слота невозможен
+template <typename T, typename Alloc = NewDeleteAllocator<T>>
+class ConcurrentVector {
+public:
+	ConcurrentVector() = default;
+
+	explicit ConcurrentVector(Alloc alloc)
+		: alloc_(std::move(alloc)) {
+	}
+
+	ConcurrentVector(const ConcurrentVector&) = delete;
+
+	ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+	~ConcurrentVector() {
+		DestroyAndFree();
+	}
+
+	// Потокобезопасно; возвращает индекс добавленного элемента
+	template <typename... Args>
+	size_t EmplaceBack(Args&&... args) {
+		const size_t index = size_.fetch_add(1, std::memory_order_relaxed);
+		new (SlotFor(index)) T(std::forward<Args>(args)...);
+		return index;
+	}
+
+	size_t PushBack(const T& value) {
+		return EmplaceBack(value);
+	}
+
+	size_t PushBack(T&& value) {
+		return EmplaceBack(std::move(value));
+	}
+
+	// Нижняя оценка числа элементов во время фазы записи, точное число — после
+	size_t Size() const noexcept {
+		return size_.load(std::memory_order_acquire);
+	}
+
+	// Доступ по индексу корректен только к элементам, чья запись уже завершена
+	const T& operator[](size_t index) const noexcept {
+		assert(index < Size());
+		return *const_cast<ConcurrentVector&>(*this).SlotFor(index);
+	}
+
+	// Переносит все элементы в непрерывный Vector и опустошает сегменты.
+	// Вызывается строго после завершения всех продюсеров
+	Vector<T> Freeze() {
+		const size_t total = size_.load(std::memory_order_acquire);
+		Vector<T> result;
+		result.Reserve(total);
+		size_t remaining = total;
+		for (size_t seg = 0; seg < NUM_SEGMENTS && remaining > 0; ++seg) {
+			T* base = segments_[seg].load(std::memory_order_relaxed);
+			const size_t in_segment = remaining < SegmentCapacity(seg) ? remaining : SegmentCapacity(seg);
+			result.AppendBack(std::make_move_iterator(base), std::make_move_iterator(base + in_segment));
+			remaining -= in_segment;
+		}
+		DestroyAndFree();
+		size_.store(0, std::memory_order_relaxed);
+		return result;
+	}
+
+private:
+	static const size_t BASE_CAPACITY = size_t{1} << 10u;
+	static const size_t NUM_SEGMENTS = 48;
+
+	// Сегмент k хранит индексы [BASE * (2^k - 1), BASE * (2^(k+1) - 1))
+	static size_t SegmentIndex(size_t index) noexcept {
+		size_t q = index / BASE_CAPACITY + 1;
+		size_t seg = 0;
+		while (q > 1) {
+			q >>= 1u;
+			++seg;
+		}
+		return seg;
+	}
+
+	static size_t SegmentCapacity(size_t seg) noexcept {
+		return BASE_CAPACITY << seg;
+	}
+
+	static size_t SegmentBegin(size_t seg) noexcept {
+		return BASE_CAPACITY * ((size_t{1} << seg) - 1);
+	}
+
+	// Возвращает адрес слота, при необходимости публикуя новый сегмент через CAS;
+	// проигравший гонку поток освобождает свой лишний сегмент
+	T* SlotFor(size_t index) {
+		const size_t seg = SegmentIndex(index);
+		T* base = segments_[seg].load(std::memory_order_acquire);
+		if (base == nullptr) {
+			T* fresh = alloc_.Allocate(SegmentCapacity(seg));
+			if (segments_[seg].compare_exchange_strong(base, fresh,
+				std::memory_order_acq_rel, std::memory_order_acquire)) {
+				base = fresh;
+			}
+			else {
+				alloc_.Deallocate(fresh, SegmentCapacity(seg));
+			}
+		}
+		return base + (index - SegmentBegin(seg));
+	}
+
+	void DestroyAndFree() noexcept {
+		size_t remaining = size_.load(std::memory_order_relaxed);
+		for (size_t seg = 0; seg < NUM_SEGMENTS; ++seg) {
+			T* base = segments_[seg].exchange(nullptr, std::memory_order_relaxed);
+			if (base == nullptr) {
+				continue;
+			}
+			const size_t in_segment = remaining < SegmentCapacity(seg) ? remaining : SegmentCapacity(seg);
+			std::destroy_n(base, in_segment);
+			remaining -= in_segment;
+			alloc_.Deallocate(base, SegmentCapacity(seg));
+		}
+	}
+
+	Alloc alloc_{};
+	std::atomic<T*> segments_[NUM_SEGMENTS] = {};
+	std::atomic<size_t> size_{0};
+};
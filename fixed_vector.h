@@ -0,0 +1,195 @@
+﻿#pragma once
+#include "vector.h"
+
+// Вектор фиксированной ёмкости: N слотов лежат внутри самого объекта, куча не
+// используется вовсе — ни одна операция не аллоцирует и не переносит элементы.
+// Реакция на переполнение выбирается политикой на этапе компиляции:
+//  - ASSERT — нарушение контракта, ловится assert (в NDEBUG элемент отбрасывается);
+//  - THROW  — std::length_error, состояние контейнера не меняется;
+//  - DROP   — элемент молча отбрасывается (телеметрия, кольцевые журналы).
+// Для явной обработки переполнения без политики есть TryPushBack
+enum class OverflowPolicy {
+	ASSERT,
+	THROW,
+	DROP,
+};
+
+template <typename T, size_t N, OverflowPolicy POLICY = OverflowPolicy::ASSERT>
+class FixedVector {
+	static_assert(N > 0, "FixedVector requires a non-zero capacity");
+
+public:
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	FixedVector() = default;
+
+	explicit FixedVector(size_t size) {
+		Resize(size);
+	}
+
+	FixedVector(const FixedVector& other) {
+		std::uninitialized_copy_n(other.Data(), other.size_, Data());
+		size_ = other.size_;
+	}
+
+	FixedVector(FixedVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		std::uninitialized_move_n(other.Data(), other.size_, Data());
+		size_ = other.size_;
+	}
+
+	~FixedVector() {
+		std::destroy_n(Data(), size_);
+	}
+
+	FixedVector& operator=(const FixedVector& rhs) {
+		if (this != &rhs) {
+			FixedVector rhs_copy(rhs);
+			std::destroy_n(Data(), size_);
+			size_ = 0;
+			std::uninitialized_move_n(rhs_copy.Data(), rhs_copy.size_, Data());
+			size_ = rhs_copy.size_;
+		}
+		return *this;
+	}
+
+	FixedVector& operator=(FixedVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		if (this != &rhs) {
+			std::destroy_n(Data(), size_);
+			size_ = 0;
+			std::uninitialized_move_n(rhs.Data(), rhs.size_, Data());
+			size_ = rhs.size_;
+		}
+		return *this;
+	}
+
+	iterator begin() noexcept {
+		return Data();
+	}
+
+	iterator end() noexcept {
+		return Data() + size_;
+	}
+
+	const_iterator begin() const noexcept {
+		return Data();
+	}
+
+	const_iterator end() const noexcept {
+		return Data() + size_;
+	}
+
+	const_iterator cbegin() const noexcept {
+		return begin();
+	}
+
+	const_iterator cend() const noexcept {
+		return end();
+	}
+
+	size_t Size() const noexcept {
+		return size_;
+	}
+
+	static constexpr size_t Capacity() noexcept {
+		return N;
+	}
+
+	bool Empty() const noexcept {
+		return size_ == 0;
+	}
+
+	bool Full() const noexcept {
+		return size_ == N;
+	}
+
+	const T& operator[](size_t index) const noexcept {
+		return const_cast<FixedVector&>(*this)[index];
+	}
+
+	T& operator[](size_t index) noexcept {
+		assert(index < size_);
+		return Data()[index];
+	}
+
+	void PushBack(const T& value) {
+		EmplaceBack(value);
+	}
+
+	void PushBack(T&& value) {
+		EmplaceBack(std::move(value));
+	}
+
+	// Добавляет элемент, если есть место; false — при заполненной ёмкости.
+	// Единственный путь переполнения, не проходящий через политику
+	bool TryPushBack(const T& value) {
+		if (size_ == N) {
+			return false;
+		}
+		new (Data() + size_) T(value);
+		++size_;
+		return true;
+	}
+
+	// При переполнении с политикой DROP возвращает последний живой элемент
+	template <typename... Args>
+	T& EmplaceBack(Args&&... args) {
+		if (size_ == N) {
+			OverflowGuard();
+			return Data()[size_ - 1u];
+		}
+		new (Data() + size_) T(std::forward<Args>(args)...);
+		++size_;
+		return Data()[size_ - 1u];
+	}
+
+	void PopBack() noexcept {
+		std::destroy_at(Data() + size_ - 1u);
+		--size_;
+	}
+
+	void Resize(size_t new_size) {
+		if (new_size > N) {
+			OverflowGuard();
+			new_size = N;
+		}
+		if (new_size < size_) {
+			std::destroy_n(Data() + new_size, size_ - new_size);
+		}
+		else {
+			std::uninitialized_value_construct_n(Data() + size_, new_size - size_);
+		}
+		size_ = new_size;
+	}
+
+	void Clear() noexcept {
+		std::destroy_n(Data(), size_);
+		size_ = 0;
+	}
+
+private:
+	static void OverflowGuard() {
+		if constexpr (POLICY == OverflowPolicy::THROW) {
+#if VECTOR_HAS_EXCEPTIONS
+			throw std::length_error("FixedVector: capacity exceeded");
+#else
+			assert(false && "FixedVector: capacity exceeded");
+			std::abort();
+#endif
+		}
+		else if constexpr (POLICY == OverflowPolicy::ASSERT) {
+			assert(false && "FixedVector: capacity exceeded");
+		}
+	}
+
+	T* Data() noexcept {
+		return reinterpret_cast<T*>(buf_);
+	}
+
+	const T* Data() const noexcept {
+		return const_cast<FixedVector&>(*this).Data();
+	}
+
+	alignas(T) unsigned char buf_[N * sizeof(T)];
+	size_t size_ = 0;
+};
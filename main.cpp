@@ -1,8 +1,28 @@
-﻿#include "vector.h"
+﻿// Тесты гоняются с включённым параллельным режимом массовых операций
+// и со сбором статистики аллокаций
+#define VECTOR_PARALLEL_BULK
+#define VECTOR_STATS
 
+#include "allocators.h"
+#include "bit_vector.h"
+#include "concurrent_vector.h"
+#include "fixed_vector.h"
+#include "mapped_vector.h"
+#include "segmented_vector.h"
+#include "shared_vector.h"
+#include "small_vector.h"
+#include "soa_vector.h"
+#include "sorted_vector.h"
+#include "stable_vector.h"
+#include "vector.h"
+#include "vector_io.h"
+
+#include <cstdio>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace {
@@ -421,6 +441,21 @@ void Test6() {
         assert(v.cbegin() == cv.begin());
         assert(v.cend() == cv.end());
     }
+    {
+        // Вставка и удаление для тривиально копируемых типов идут по ускоренному пути
+        Vector<int> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.PushBack(i);
+        }
+        auto* pos = v.Insert(v.cbegin() + 3, ID);
+        assert(v.Size() == SIZE + 1);
+        assert(*pos == ID);
+        assert(v[2] == 2 && v[4] == 3);
+        pos = v.Erase(v.cbegin() + 3);
+        assert(v.Size() == SIZE);
+        assert(*pos == 3);
+        assert(v[SIZE - 1] == static_cast<int>(SIZE) - 1);
+    }
     {
         Obj::ResetCounters();
         Vector<Obj> v{ SIZE };
@@ -563,6 +598,1319 @@ void Test6() {
     }
 }
 
+void Test7() {
+    const size_t SIZE = 100;
+    const int MAGIC = 42;
+    {
+        // Векторы на арене: корректная работа и массовое освобождение через Reset
+        MemoryArena arena;
+        Vector<int, ArenaAllocator<int>> v{ ArenaAllocator<int>{arena} };
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        assert(v.Size() == SIZE);
+        assert(v[SIZE - 1] == static_cast<int>(SIZE) - 1);
+
+        Vector<Obj, ArenaAllocator<Obj>> objs{ ArenaAllocator<Obj>{arena} };
+        Obj::ResetCounters();
+        objs.PushBack(Obj{ MAGIC });
+        assert(objs[0].id == MAGIC);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Пул переиспользует буфер: повторное выделение того же размера возвращает тот же блок
+        const int* old_address = nullptr;
+        {
+            Vector<int, PoolAllocator<int>> v;
+            v.Reserve(SIZE);
+            old_address = v.begin();
+        }
+        Vector<int, PoolAllocator<int>> v;
+        v.Reserve(SIZE);
+        assert(v.begin() == old_address);
+        v.Resize(SIZE);
+        v[SIZE - 1] = MAGIC;
+        assert(v[SIZE - 1] == MAGIC);
+    }
+    {
+        // Копия и перемещение сохраняют аллокатор исходного вектора
+        MemoryArena arena;
+        Vector<int, ArenaAllocator<int>> v{ ArenaAllocator<int>{arena} };
+        v.PushBack(MAGIC);
+        auto v_copy(v);
+        assert(v_copy[0] == MAGIC);
+        auto v_moved(std::move(v_copy));
+        v_moved.PushBack(MAGIC);
+        assert(v_moved.Size() == 2);
+    }
+}
+
+void Test8() {
+    const size_t INLINE_CAPACITY = 8;
+    const int ID = 42;
+    {
+        // Пока элементов не больше N, куча не используется
+        Obj::ResetCounters();
+        SmallVector<Obj, INLINE_CAPACITY> v;
+        assert(v.Size() == 0);
+        assert(v.Capacity() == INLINE_CAPACITY);
+        for (size_t i = 0; i < INLINE_CAPACITY; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        assert(!v.IsSpilled());
+        assert(v.Size() == INLINE_CAPACITY);
+        assert(v[INLINE_CAPACITY - 1].id == static_cast<int>(INLINE_CAPACITY) - 1);
+
+        // Переполнение встроенного буфера переводит вектор на кучу
+        v.EmplaceBack(ID);
+        assert(v.IsSpilled());
+        assert(v.Capacity() == INLINE_CAPACITY * 2);
+        assert(v.Size() == INLINE_CAPACITY + 1);
+        assert(v[INLINE_CAPACITY].id == ID);
+        assert(v[0].id == 0);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        SmallVector<int, 4> v;
+        v.PushBack(ID);
+        auto v_copy(v);
+        assert(v_copy.Size() == 1);
+        assert(v_copy[0] == ID);
+        assert(&v_copy[0] != &v[0]);
+
+        auto v_moved(std::move(v_copy));
+        assert(v_moved.Size() == 1);
+        assert(v_moved[0] == ID);
+        v = v_moved;
+        assert(v.Size() == 1 && v[0] == ID);
+    }
+    {
+        // PushBack собственного элемента безопасен и при уходе с встроенного буфера
+        SmallVector<TestObj, 1> v(1);
+        assert(v.Size() == v.Capacity());
+        v.PushBack(v[0]);
+        assert(v[0].IsAlive());
+        assert(v[1].IsAlive());
+    }
+    {
+        SmallVector<std::string, 2> v;
+        v.PushBack("hello");
+        v.EmplaceBack(100, 'a');
+        v.PushBack("world");
+        assert(v.IsSpilled());
+        assert(v[0] == "hello" && v[2] == "world");
+        v.PopBack();
+        assert(v.Size() == 2);
+    }
+    {
+        // Аллокатор с состоянием переживает уход с встроенного буфера и переносы
+        MemoryArena arena;
+        SmallVector<int, 2, ArenaAllocator<int>> v{ArenaAllocator<int>(arena)};
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.IsSpilled());
+        assert(v[0] == 0 && v[9] == 9);
+
+        auto v_copy(v);
+        v_copy.PushBack(ID);
+        assert(v_copy.Size() == 11 && v_copy[10] == ID);
+
+        SmallVector<int, 2, ArenaAllocator<int>> v_moved(std::move(v_copy));
+        v_moved.Reserve(100);
+        assert(v_moved.Size() == 11 && v_moved[10] == ID);
+    }
+}
+
+namespace {
+
+    // Тип с бросающим копированием и без перемещения: заводит Insert
+    // в копирующую ветку реаллокации
+    struct FragileCopy {
+        FragileCopy() {
+            ++alive;
+        }
+        FragileCopy(const FragileCopy& /*other*/) {
+            if (throw_countdown > 0 && --throw_countdown == 0) {
+                throw std::runtime_error("Oops");
+            }
+            ++alive;
+        }
+        ~FragileCopy() {
+            --alive;
+        }
+
+        static inline int alive = 0;
+        static inline int throw_countdown = 0;
+    };
+
+}  // namespace
+
+void Test9() {
+    using namespace std::literals;
+    const int ID = 42;
+    {
+        const std::vector<int> batch = { 1, 2, 3, 4, 5 };
+        Vector<int> v;
+        auto* pos = v.AppendBack(batch.begin(), batch.end());
+        assert(v.Size() == batch.size());
+        assert(pos == v.begin());
+        assert(v[0] == 1 && v[4] == 5);
+
+        // Повторное добавление не должно реаллоцировать больше одного раза
+        v.AppendBack(batch.begin(), batch.end());
+        assert(v.Size() == batch.size() * 2);
+        assert(v[5] == 1 && v[9] == 5);
+
+        pos = v.AppendBack(3, ID);
+        assert(v.Size() == batch.size() * 2 + 3);
+        assert(*pos == ID && v[v.Size() - 1] == ID);
+    }
+    {
+        // Заполнение собственным элементом переживает реаллокацию
+        Vector<int> v;
+        v.PushBack(ID);
+        v.AppendBack(v.Capacity() * 2, v[0]);
+        assert(v[v.Size() - 1] == ID);
+    }
+    {
+        // Вставка диапазона с реаллокацией и без неё
+        Obj::ResetCounters();
+        const std::vector<Obj> batch(3);
+        Vector<Obj> v;
+        v.Reserve(10);
+        for (int i = 0; i < 4; ++i) {
+            v.EmplaceBack(i);
+        }
+        auto* pos = v.Insert(v.cbegin() + 2, batch.begin(), batch.end());
+        assert(v.Size() == 7);
+        assert(pos == v.begin() + 2);
+        assert(v[1].id == 1 && v[2].id == 0 && v[5].id == 2 && v[6].id == 3);
+
+        // Диапазон длиннее хвоста: часть уходит в неинициализированную область
+        v.Insert(v.cend() - 1, batch.begin(), batch.end());
+        assert(v.Size() == 10);
+        assert(v[9].id == 3);
+
+        // Вставка при заполненной ёмкости
+        v.Insert(v.cbegin() + 1, batch.begin(), batch.end());
+        assert(v.Size() == 13);
+        assert(v.Capacity() == 20);
+        assert(v[0].id == 0 && v[4].id == 1);
+        assert(Obj::GetAliveObjectCount() == 13 + 3);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Vector<std::string> v;
+        const std::vector<std::string> batch = { "a"s, "b"s };
+        v.Insert(v.cend(), batch.begin(), batch.end());
+        assert(v.Size() == 2 && v[0] == "a"s && v[1] == "b"s);
+    }
+    {
+        // Бросок копии старых элементов при реаллокации не теряет уже
+        // построенные в новом буфере вставляемые элементы
+        FragileCopy::alive = 0;
+        FragileCopy::throw_countdown = 0;
+        const std::vector<FragileCopy> batch(2);
+        Vector<FragileCopy> v;
+        for (int i = 0; i < 4; ++i) {
+            v.EmplaceBack();
+        }
+        assert(v.Capacity() == 4);
+        // 2 копии диапазона проходят, бросает вторая копия префикса
+        FragileCopy::throw_countdown = 4;
+        try {
+            v.Insert(v.cbegin() + 2, batch.begin(), batch.end());
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        FragileCopy::throw_countdown = 0;
+        assert(v.Size() == 4);
+        assert(FragileCopy::alive == 4 + 2);
+    }
+    {
+        // Та же реаллокационная ветка Emplace: бросок копии старых элементов
+        // пробрасывается наружу, а вектор остаётся нетронутым
+        FragileCopy::alive = 0;
+        FragileCopy::throw_countdown = 0;
+        Vector<FragileCopy> v;
+        for (int i = 0; i < 4; ++i) {
+            v.EmplaceBack();
+        }
+        assert(v.Capacity() == 4);
+        // Бросает вторая копия префикса
+        FragileCopy::throw_countdown = 2;
+        try {
+            v.Emplace(v.cbegin() + 2);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        // Бросает первая копия хвоста
+        FragileCopy::throw_countdown = 3;
+        try {
+            v.Emplace(v.cbegin() + 2);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        FragileCopy::throw_countdown = 0;
+        assert(v.Size() == 4);
+        assert(FragileCopy::alive == 4);
+    }
+}
+
+void Test10() {
+    const size_t SIZE = 1000;
+    {
+        // Для тривиальных типов память не инициализируется, но size и capacity корректны
+        Vector<int> v;
+        v.ResizeForOverwrite(SIZE);
+        assert(v.Size() == SIZE);
+        assert(v.Capacity() == SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i] = static_cast<int>(i);
+        }
+        assert(v[SIZE - 1] == static_cast<int>(SIZE) - 1);
+
+        // Уменьшение размера работает как у Resize
+        v.ResizeForOverwrite(SIZE / 2);
+        assert(v.Size() == SIZE / 2);
+        assert(v.Capacity() == SIZE);
+        assert(v[SIZE / 2 - 1] == static_cast<int>(SIZE) / 2 - 1);
+    }
+    {
+        // Нетривиальные типы по-прежнему конструируются и разрушаются
+        Obj::ResetCounters();
+        Vector<Obj> v;
+        v.ResizeForOverwrite(SIZE);
+        assert(v.Size() == SIZE);
+        assert(Obj::num_default_constructed == SIZE);
+        v.ResizeForOverwrite(0);
+        assert(Obj::num_destroyed == SIZE);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test11() {
+    const size_t SIZE = 100;
+    const int ID = 42;
+    {
+        // ShrinkToFit возвращает лишнюю ёмкость, сохраняя элементы
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v[SIZE - 1].id = ID;
+        v.Reserve(SIZE * 4);
+        assert(v.Capacity() == SIZE * 4);
+        v.ShrinkToFit();
+        assert(v.Capacity() == SIZE);
+        assert(v.Size() == SIZE);
+        assert(v[SIZE - 1].id == ID);
+        assert(Obj::GetAliveObjectCount() == SIZE);
+
+        v.Resize(SIZE / 2);
+        v.ShrinkToFit();
+        assert(v.Capacity() == SIZE / 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Политика полуторного роста даёт последовательность 1, 2, 3, 4, 6, 9, ...
+        Vector<int, NewDeleteAllocator<int>, GrowthX1_5> v;
+        v.PushBack(0);
+        assert(v.Capacity() == 1);
+        v.PushBack(1);
+        assert(v.Capacity() == 2);
+        v.PushBack(2);
+        assert(v.Capacity() == 3);
+        v.PushBack(3);
+        v.PushBack(4);
+        assert(v.Capacity() == 4 + 2);
+    }
+    {
+        // Постраничная политика сразу выделяет буфер, кратный странице
+        Vector<int, NewDeleteAllocator<int>, GrowthPageQuantized> v;
+        v.PushBack(ID);
+        assert(v.Capacity() * sizeof(int) % GrowthPageQuantized::PAGE_SIZE == 0);
+        assert(v[0] == ID);
+    }
+}
+
+void Test12() {
+    const size_t ALIGNMENT = 64;
+    {
+        // Выравнивание сохраняется при всех реаллокациях
+        Vector<float, AlignedAllocator<float, ALIGNMENT>> v;
+        for (size_t i = 0; i < 1000; ++i) {
+            v.PushBack(static_cast<float>(i));
+            assert(reinterpret_cast<uintptr_t>(v.begin()) % ALIGNMENT == 0);
+        }
+        assert(v[999] == 999.0f);
+    }
+    {
+        // Крупный буфер через huge pages (на Linux), мелкий — через operator new
+        const size_t LARGE_SIZE = (size_t{4} << 20u) / sizeof(double);
+        Vector<double, HugePageAllocator<double>> v;
+        v.Resize(LARGE_SIZE);
+        v[LARGE_SIZE - 1] = 1.5;
+        assert(v.Size() == LARGE_SIZE);
+        assert(v[LARGE_SIZE - 1] == 1.5);
+
+        Vector<double, HugePageAllocator<double>> small;
+        small.PushBack(2.5);
+        assert(small[0] == 2.5);
+    }
+}
+
+void Test13() {
+    const size_t SIZE = 10000;
+    {
+        // Рост через realloc: содержимое сохраняется при всех расширениях
+        Vector<int, MallocAllocator<int>> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        assert(v.Size() == SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            assert(v[i] == static_cast<int>(i));
+        }
+        v.Reserve(SIZE * 4);
+        assert(v.Capacity() == SIZE * 4);
+        assert(v[SIZE - 1] == static_cast<int>(SIZE) - 1);
+    }
+    {
+        // PushBack собственного элемента безопасен и на realloc-пути
+        Vector<int, MallocAllocator<int>> v;
+        v.PushBack(1);
+        while (v.Size() < v.Capacity()) {
+            v.PushBack(0);
+        }
+        v[0] = 42;
+        v.PushBack(v[0]);
+        assert(v[v.Size() - 1] == 42);
+    }
+    {
+        // Нетривиальные типы продолжают ходить через перемещение в новый буфер
+        Vector<std::string, MallocAllocator<std::string>> v;
+        for (size_t i = 0; i < 100; ++i) {
+            v.EmplaceBack("string-" + std::to_string(i));
+        }
+        assert(v[99] == "string-99");
+    }
+}
+
+void Test14() {
+#if defined(__unix__) || defined(__APPLE__)
+    const size_t SIZE = 100000;
+    const char* PATH = "test_mapped_vector.bin";
+    {
+        Vector<double> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<double>(i) * 0.5);
+        }
+        FlushToFile(v, PATH);
+
+        MappedVector<double> mapped(PATH);
+        assert(mapped.Size() == SIZE);
+        assert(mapped[0] == 0.0);
+        assert(mapped[SIZE - 1] == static_cast<double>(SIZE - 1) * 0.5);
+        assert(std::equal(v.begin(), v.end(), mapped.begin()));
+
+        auto copy = mapped.ToVector();
+        assert(copy.Size() == SIZE);
+        assert(copy[SIZE / 2] == mapped[SIZE / 2]);
+    }
+    {
+        // Несовпадение типа элемента обнаруживается по заголовку
+        try {
+            MappedVector<int> mapped(PATH);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+    }
+    std::remove(PATH);
+#endif
+}
+
+void Test15() {
+    // Размер выше порога VECTOR_PARALLEL_THRESHOLD — массовые операции идут по потокам
+    const size_t SIZE = (size_t{1} << 21u) + 13;
+    {
+        Vector<int> v(SIZE);
+        assert(v.Size() == SIZE);
+        assert(v[0] == 0 && v[SIZE - 1] == 0);
+        v[SIZE - 1] = 42;
+
+        auto v_copy(v);
+        assert(v_copy.Size() == SIZE);
+        assert(v_copy[SIZE - 1] == 42);
+
+        // Достройка идёт default-инициализацией: для int значения неопределённы,
+        // проверяем размер, сохранность старых элементов и запись в новые
+        v.Resize(SIZE * 2);
+        assert(v.Size() == SIZE * 2);
+        assert(v[SIZE - 1] == 42);
+        v[SIZE * 2 - 1] = 7;
+        assert(v[SIZE * 2 - 1] == 7);
+    }
+    {
+        // Типы с бросающим конструктором остаются на последовательном пути
+        Obj::ResetCounters();
+        Vector<Obj> v(1000);
+        assert(Obj::num_default_constructed == 1000);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+namespace {
+
+    // Отдельный тип элементов, чтобы статистика не пересекалась с другими тестами
+    struct StatsProbe {
+        long long value = 0;
+    };
+
+    int num_realloc_callbacks = 0;
+
+    void CountReallocation(size_t /*old_capacity*/, size_t /*new_capacity*/) {
+        ++num_realloc_callbacks;
+    }
+
+}  // namespace
+
+void Test16() {
+    auto& stats = Vector<StatsProbe>::GetStats();
+    stats.Reset();
+    stats.on_reallocation = &CountReallocation;
+    {
+        Vector<StatsProbe> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(StatsProbe{ i });
+        }
+        // Рост 1 -> 2 -> 4 -> ... -> 128: семь реаллокаций после первого выделения
+        assert(stats.allocations >= 8);
+        assert(stats.reallocations == 7);
+        assert(stats.peak_capacity == 128);
+        assert(stats.bytes_copied > 0);
+        assert(num_realloc_callbacks == 7);
+        assert(v.WastedBytes() == (v.Capacity() - v.Size()) * sizeof(StatsProbe));
+
+        v.ShrinkToFit();
+        assert(stats.reallocations == 8);
+        assert(v.WastedBytes() == 0);
+    }
+    stats.on_reallocation = nullptr;
+}
+
+namespace {
+
+    // Нетривиально копируемая обёртка над указателем на кучу. Самоссылок нет
+    // (в отличие, например, от SSO-строк), поэтому объект можно безопасно
+    // переносить побайтово — это и объявляет специализация IsTriviallyRelocatable ниже
+    struct RelocObj {
+        explicit RelocObj(int value)
+            : value(new int(value)) {
+        }
+        RelocObj(const RelocObj& other)
+            : value(new int(*other.value)) {
+            ++copies;
+        }
+        RelocObj(RelocObj&& other) noexcept
+            : value(std::exchange(other.value, nullptr)) {
+            ++moves;
+        }
+        RelocObj& operator=(const RelocObj& rhs) {
+            if (this != &rhs) {
+                delete value;
+                value = new int(*rhs.value);
+            }
+            return *this;
+        }
+        RelocObj& operator=(RelocObj&& rhs) noexcept {
+            if (this != &rhs) {
+                delete value;
+                value = std::exchange(rhs.value, nullptr);
+            }
+            return *this;
+        }
+        ~RelocObj() {
+            delete value;
+        }
+
+        int* value;
+
+        inline static size_t copies = 0;
+        inline static size_t moves = 0;
+    };
+
+}  // namespace
+
+template <>
+struct IsTriviallyRelocatable<RelocObj> : std::true_type {};
+
+void Test17() {
+    static_assert(!std::is_trivially_copyable_v<RelocObj>);
+    static_assert(IsTriviallyRelocatableV<RelocObj>);
+
+    Vector<RelocObj> v;
+    for (int i = 0; i < 100; ++i) {
+        v.EmplaceBack(i);
+    }
+    RelocObj::copies = 0;
+    RelocObj::moves = 0;
+    // Рост 128 -> 256: элементы переезжают одним блочным копированием,
+    // без вызовов move-конструкторов и деструкторов исходников
+    v.Reserve(256);
+    assert(RelocObj::copies == 0);
+    assert(RelocObj::moves == 0);
+    for (int i = 0; i < 100; ++i) {
+        assert(*v[i].value == i);
+    }
+
+    // Вставка и удаление в середине тоже идут через блочный перенос хвоста
+    v.Emplace(v.begin() + 50, 1000);
+    assert(*v[50].value == 1000);
+    assert(*v[51].value == 50);
+    v.Erase(v.begin() + 50);
+    assert(*v[50].value == 50);
+    assert(v.Size() == 100);
+
+    SmallVector<RelocObj, 4> sv;
+    for (int i = 0; i < 10; ++i) {
+        sv.EmplaceBack(i);
+    }
+    for (int i = 0; i < 10; ++i) {
+        assert(*sv[i].value == i);
+    }
+}
+
+void Test18() {
+    // Assign в пределах ёмкости переиспользует буфер: адрес данных не меняется
+    Vector<std::string> v;
+    for (int i = 0; i < 8; ++i) {
+        v.PushBack("old-" + std::to_string(i));
+    }
+    const std::string* buf = v.begin();
+    const size_t capacity = v.Capacity();
+
+    const std::vector<std::string> shorter = { "a", "b", "c" };
+    v.Assign(shorter.begin(), shorter.end());
+    assert(v.Size() == 3);
+    assert(v.Capacity() == capacity);
+    assert(v.begin() == buf);
+    assert(v[0] == "a" && v[1] == "b" && v[2] == "c");
+
+    const std::vector<std::string> longer = { "p", "q", "r", "s", "t" };
+    v.Assign(longer.begin(), longer.end());
+    assert(v.Size() == 5);
+    assert(v.begin() == buf);
+    assert(v[0] == "p" && v[4] == "t");
+
+    // Нехватка ёмкости — ровно одна реаллокация, старое содержимое не копируется
+    std::vector<std::string> big;
+    for (int i = 0; i < 100; ++i) {
+        big.push_back("big-" + std::to_string(i));
+    }
+    v.Assign(big.begin(), big.end());
+    assert(v.Size() == 100);
+    assert(v.Capacity() == 100);
+    for (int i = 0; i < 100; ++i) {
+        assert(v[i] == "big-" + std::to_string(i));
+    }
+
+    // Assign(count, value), включая value внутри самого вектора
+    v.Assign(4, std::string("xyz"));
+    assert(v.Size() == 4);
+    for (size_t i = 0; i < v.Size(); ++i) {
+        assert(v[i] == "xyz");
+    }
+    v.Assign(200, v[1]);
+    assert(v.Size() == 200);
+    for (size_t i = 0; i < v.Size(); ++i) {
+        assert(v[i] == "xyz");
+    }
+
+    Vector<int> nums;
+    nums.Assign(5, 7);
+    assert(nums.Size() == 5 && nums[0] == 7 && nums[4] == 7);
+    const int raw[] = { 1, 2, 3 };
+    nums.Assign(std::begin(raw), std::end(raw));
+    assert(nums.Size() == 3 && nums[2] == 3);
+}
+
+void Test19() {
+    // Erase диапазона: хвост сдвигается один раз
+    Vector<std::string> v;
+    for (int i = 0; i < 10; ++i) {
+        v.PushBack("s-" + std::to_string(i));
+    }
+    auto it = v.Erase(v.begin() + 2, v.begin() + 6);
+    assert(v.Size() == 6);
+    assert(it == v.begin() + 2);
+    assert(v[1] == "s-1" && v[2] == "s-6" && v[5] == "s-9");
+
+    // Пустой диапазон и диапазон до конца
+    it = v.Erase(v.begin() + 3, v.begin() + 3);
+    assert(v.Size() == 6 && it == v.begin() + 3);
+    v.Erase(v.begin() + 4, v.end());
+    assert(v.Size() == 4 && v[3] == "s-7");
+
+    Vector<int> nums;
+    for (int i = 0; i < 8; ++i) {
+        nums.PushBack(i);
+    }
+    nums.Erase(nums.begin() + 1, nums.begin() + 7);
+    assert(nums.Size() == 2 && nums[0] == 0 && nums[1] == 7);
+
+    // EraseUnordered: на место удалённого переезжает последний элемент
+    Vector<std::string> pool;
+    for (int i = 0; i < 5; ++i) {
+        pool.PushBack("p-" + std::to_string(i));
+    }
+    auto pos = pool.EraseUnordered(pool.begin() + 1);
+    assert(pool.Size() == 4);
+    assert(*pos == "p-4");
+    assert(pool[0] == "p-0" && pool[2] == "p-2" && pool[3] == "p-3");
+
+    // Удаление последнего элемента — просто PopBack
+    pool.EraseUnordered(pool.begin() + 3);
+    assert(pool.Size() == 3 && pool[2] == "p-2");
+
+    Vector<int> ids;
+    for (int i = 0; i < 4; ++i) {
+        ids.PushBack(i);
+    }
+    ids.EraseUnordered(ids.begin());
+    assert(ids.Size() == 3 && ids[0] == 3 && ids[1] == 1 && ids[2] == 2);
+}
+
+void Test20() {
+    // Многопоточное наполнение: каждый продюсер кладёт свой диапазон значений,
+    // после join содержимое замораживается в обычный Vector
+    const size_t NUM_THREADS = 8;
+    const size_t PER_THREAD = 10'000;
+    ConcurrentVector<size_t> cv;
+    {
+        std::vector<std::thread> producers;
+        for (size_t t = 0; t < NUM_THREADS; ++t) {
+            producers.emplace_back([&cv, t] {
+                for (size_t i = 0; i < PER_THREAD; ++i) {
+                    cv.PushBack(t * PER_THREAD + i);
+                }
+            });
+        }
+        for (auto& p : producers) {
+            p.join();
+        }
+    }
+    assert(cv.Size() == NUM_THREADS * PER_THREAD);
+
+    Vector<size_t> frozen = cv.Freeze();
+    assert(frozen.Size() == NUM_THREADS * PER_THREAD);
+    assert(cv.Size() == 0);
+    // Порядок недетерминирован — проверяется, что каждое значение встретилось ровно один раз
+    std::vector<char> seen(NUM_THREADS * PER_THREAD, 0);
+    for (size_t value : frozen) {
+        assert(value < seen.size());
+        assert(seen[value] == 0);
+        seen[value] = 1;
+    }
+
+    // Замороженный контейнер можно наполнять заново, в том числе нетривиальными типами
+    ConcurrentVector<std::string> names;
+    const size_t index = names.EmplaceBack(std::string(100, 'x'));
+    names.PushBack(std::string("short"));
+    assert(index == 0);
+    assert(names.Size() == 2);
+    assert(names[0] == std::string(100, 'x'));
+    Vector<std::string> name_list = names.Freeze();
+    assert(name_list.Size() == 2 && name_list[1] == "short");
+}
+
+void Test21() {
+    // Выравнивание буфера сохраняется при всех реаллокациях
+    AlignedVector<float, 64> v;
+    for (int i = 0; i < 1000; ++i) {
+        v.PushBack(static_cast<float>(i));
+        assert(reinterpret_cast<uintptr_t>(v.begin()) % 64 == 0);
+    }
+
+    // Find: попадания в начале, в середине блока, в хвосте и промах
+    assert(v.Find(0.f) == v.begin());
+    assert(v.Find(537.f) == v.begin() + 537);
+    assert(v.Find(999.f) == v.begin() + 999);
+    assert(v.Find(-1.f) == v.end());
+
+    // Fill и Equal для арифметических типов
+    AlignedVector<float, 64> w;
+    w.Resize(v.Size());
+    w.Fill(3.5f);
+    for (float x : w) {
+        assert(x == 3.5f);
+    }
+    assert(!v.Equal(w));
+    v.Fill(3.5f);
+    assert(v.Equal(w));
+    w.PopBack();
+    assert(!v.Equal(w));
+
+    // Байтовый тип идёт через memset/memcmp
+    Vector<unsigned char> bytes;
+    bytes.Resize(4096);
+    bytes.Fill(0xA5);
+    assert(bytes.Find(0xA5) == bytes.begin());
+    assert(bytes.Find(0x00) == bytes.end());
+    Vector<unsigned char> bytes2(bytes);
+    assert(bytes.Equal(bytes2));
+    bytes2[4095] = 0;
+    assert(!bytes.Equal(bytes2));
+    assert(bytes2.Find(0x00) == bytes2.end() - 1);
+
+    // Нетривиальные типы обслуживаются скалярными ветками
+    Vector<std::string> words;
+    words.PushBack("alpha");
+    words.PushBack("beta");
+    assert(words.Find("beta") == words.begin() + 1);
+    assert(words.Find("gamma") == words.end());
+    Vector<std::string> words2(words);
+    assert(words.Equal(words2));
+    words2[0] = "delta";
+    assert(!words.Equal(words2));
+}
+
+void Test22() {
+    SharedVector<std::string> sv;
+    for (int i = 0; i < 100; ++i) {
+        sv.PushBack("q-" + std::to_string(i));
+    }
+
+    // Снимок — O(1): буфер общий, глубокой копии нет
+    SharedVector<std::string> snap = sv.Snapshot();
+    assert(sv.UseCount() == 2 && snap.UseCount() == 2);
+    assert(snap.begin() == sv.begin());
+    assert(snap.Size() == 100 && snap[42] == "q-42");
+
+    // Первая запись отделяет буфер; снимок остаётся нетронутым
+    sv.PushBack("q-100");
+    assert(sv.UseCount() == 1 && snap.UseCount() == 1);
+    assert(snap.begin() != sv.begin());
+    assert(snap.Size() == 100 && sv.Size() == 101);
+    sv[0] = "changed";
+    assert(snap[0] == "q-0");
+
+    // Единоличный владелец пишет на месте, без копий
+    const std::string* buf = sv.begin();
+    sv[1] = "in-place";
+    sv.PopBack();
+    assert(sv.begin() == buf);
+
+    // Снимки можно раздавать многим читателям и разрушать независимо
+    {
+        std::vector<SharedVector<std::string>> readers(8, snap.Snapshot());
+        assert(snap.UseCount() == 9);
+        for (const auto& r : readers) {
+            assert(r[99] == "q-99");
+        }
+    }
+    assert(snap.UseCount() == 1);
+
+    // Обёртка поверх готового Vector
+    Vector<int> nums;
+    nums.PushBack(1);
+    nums.PushBack(2);
+    SharedVector<int> shared_nums(std::move(nums));
+    assert(shared_nums.Size() == 2 && shared_nums[1] == 2);
+}
+
+void Test23() {
+    // Кадр WriteTo/ReadFrom: заголовок проверяется, содержимое совпадает побайтово
+    Vector<double> v;
+    for (int i = 0; i < 1000; ++i) {
+        v.PushBack(i * 0.25);
+    }
+    std::stringstream stream;
+    WriteTo(v, stream);
+
+    Vector<double> restored;
+    ReadFrom(restored, stream);
+    assert(restored.Size() == v.Size());
+    assert(restored.Equal(v));
+
+    // Заголовок — little-endian: размер элемента в первом байте кадра
+    const std::string frame = stream.str();
+    assert(frame.size() == 16 + v.Size() * sizeof(double));
+    assert(static_cast<unsigned char>(frame[0]) == sizeof(double));
+    assert(frame[1] == 0 && frame[7] == 0);
+
+    // Чтение известного числа элементов без заголовка
+    std::stringstream raw;
+    raw.write(frame.data() + 16, static_cast<std::streamsize>(frame.size() - 16));
+    Vector<double> raw_read;
+    ReadFrom(raw_read, raw, v.Size());
+    assert(raw_read.Equal(v));
+
+    // Несовпадение типа элемента и обрыв потока дают исключение
+    std::stringstream bad(frame);
+    Vector<float> wrong;
+    try {
+        ReadFrom(wrong, bad);
+        assert(false);
+    }
+    catch (const std::runtime_error&) {
+    }
+    std::stringstream truncated(frame.substr(0, 100));
+    Vector<double> partial;
+    try {
+        ReadFrom(partial, truncated);
+        assert(false);
+    }
+    catch (const std::runtime_error&) {
+    }
+
+    // Пустой вектор — корректный кадр из одного заголовка
+    Vector<double> empty;
+    std::stringstream empty_stream;
+    WriteTo(empty, empty_stream);
+    Vector<double> empty_restored;
+    empty_restored.PushBack(1.0);
+    ReadFrom(empty_restored, empty_stream);
+    assert(empty_restored.Size() == 0);
+}
+
+namespace {
+
+    // Таблица квадратов, собранная Vector'ом целиком на этапе компиляции
+    constexpr int SquareTableEntry(size_t index) {
+        Vector<int> v;
+        for (int i = 0; i < 64; ++i) {
+            v.PushBack(i * i);
+        }
+        return v[index];
+    }
+
+    // Прогон основных операций в константных вычислениях
+    constexpr bool ConstexprVectorRoundtrip() {
+        Vector<int> v(10);
+        for (int i = 0; i < 100; ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Reserve(256);
+        Vector<int> copy(v);
+        copy = v;
+        Vector<int> moved(std::move(copy));
+        moved.PopBack();
+        moved.Resize(5);
+        moved.Resize(40);
+        return v.Size() == 110 && v.Capacity() == 256 && v[10] == 0 && v[109] == 99
+            && moved.Size() == 40 && moved[4] == v[4];
+    }
+
+}  // namespace
+
+void Test24() {
+    static_assert(SquareTableEntry(0) == 0);
+    static_assert(SquareTableEntry(7) == 49);
+    static_assert(SquareTableEntry(63) == 3969);
+    static_assert(ConstexprVectorRoundtrip());
+
+    // Те же операции в рантайме идут прежними путями
+    assert(SquareTableEntry(7) == 49);
+    assert(ConstexprVectorRoundtrip());
+}
+
+void Test25() {
+    // Append без блочных переносов: адреса элементов стабильны навсегда
+    SegmentedVector<std::string, 16> sv;
+    sv.PushBack("first");
+    const std::string* first_addr = &sv[0];
+    for (int i = 1; i < 1000; ++i) {
+        sv.PushBack("s-" + std::to_string(i));
+    }
+    assert(sv.Size() == 1000);
+    assert(&sv[0] == first_addr);
+    assert(sv[0] == "first" && sv[17] == "s-17" && sv[999] == "s-999");
+
+    // Итераторы работают с range-for и алгоритмами
+    size_t count = 0;
+    for (const std::string& s : sv) {
+        (void)s;
+        ++count;
+    }
+    assert(count == 1000);
+    auto it = std::find(sv.begin(), sv.end(), std::string("s-500"));
+    assert(it != sv.end() && it - sv.begin() == 500);
+    it->append("!");
+    assert(sv[500] == "s-500!");
+
+    // Полный random access: сравнения и арифметика в обе стороны
+    static_assert(std::random_access_iterator<decltype(sv.begin())>);
+    assert(sv.begin() < it && it > sv.begin());
+    assert(sv.begin() <= sv.begin() && sv.begin() >= sv.begin());
+    assert(*(2 + sv.begin()) == "s-2");
+    it -= 100;
+    assert(*it == "s-400");
+    assert(sv.begin()[400] == "s-400");
+
+    // PopBack освобождает элементы, ёмкость кратна размеру сегмента
+    while (sv.Size() > 3) {
+        sv.PopBack();
+    }
+    assert(sv.Size() == 3 && sv.Capacity() % 16 == 0);
+
+    // Копирование и перемещение
+    SegmentedVector<std::string, 16> copy(sv);
+    assert(copy.Size() == 3 && copy[2] == "s-2");
+    copy.PushBack("tail");
+    assert(sv.Size() == 3);
+    SegmentedVector<std::string, 16> moved(std::move(copy));
+    assert(moved.Size() == 4 && moved[3] == "tail");
+    sv = moved;
+    assert(sv.Size() == 4 && sv[3] == "tail");
+}
+
+void Test26() {
+    // Каждая политика работает и на машинах без NUMA: mbind — подсказка
+    const NumaPlacement placements[] = {
+        NumaPlacement::FIRST_TOUCH,
+        NumaPlacement::INTERLEAVE,
+        NumaPlacement::BIND,
+    };
+    for (NumaPlacement placement : placements) {
+        Vector<double, NumaAllocator<double>> v{NumaAllocator<double>(placement)};
+        // Больше MMAP_THRESHOLD — буфер идёт через mmap + mbind
+        const size_t NUM = (size_t{1} << 18u) + 17;
+        v.Resize(NUM);
+        for (size_t i = 0; i < NUM; ++i) {
+            v[i] = static_cast<double>(i);
+        }
+        v.Reserve(NUM * 3);
+        assert(v.GetAllocator().Placement() == placement);
+        for (size_t i = 0; i < NUM; i += 1000) {
+            assert(v[i] == static_cast<double>(i));
+        }
+    }
+
+    // Мелкие векторы обслуживаются обычной кучей
+    Vector<int, NumaAllocator<int>> small{NumaAllocator<int>(NumaPlacement::INTERLEAVE)};
+    for (int i = 0; i < 100; ++i) {
+        small.PushBack(i);
+    }
+    assert(small.Size() == 100 && small[99] == 99);
+}
+
+void Test27() {
+    // Адреса элементов стабильны при любом росте
+    StableVector<std::string, 64> sv;
+    std::vector<const std::string*> addresses;
+    for (int i = 0; i < 500; ++i) {
+        addresses.push_back(&sv.Emplace(std::to_string(i)));
+    }
+    assert(sv.Size() == 500 && sv.Capacity() == 512);
+    for (int i = 0; i < 500; ++i) {
+        assert(*addresses[i] == std::to_string(i));
+    }
+
+    // Erase освобождает слот, соседи не перемещаются
+    auto it = sv.GetIterator(addresses[100]);
+    assert(it != sv.end() && *it == "100");
+    it = sv.Erase(it);
+    assert(*it == "101" && sv.Size() == 499);
+    sv.Erase(sv.GetIterator(addresses[200]));
+    assert(*addresses[99] == "99" && *addresses[101] == "101");
+
+    // Свободные слоты переиспользуются LIFO, без выделения новых чанков
+    const std::string* reused_first = &sv.Emplace("reused-200");
+    const std::string* reused_second = &sv.Emplace("reused-100");
+    assert(reused_first == addresses[200] && reused_second == addresses[100]);
+    assert(sv.Size() == 500 && sv.Capacity() == 512);
+
+    // Обход пропускает дыры и видит все живые элементы ровно по разу
+    for (int i = 0; i < 500; i += 2) {
+        sv.Erase(sv.GetIterator(addresses[i]));
+    }
+    size_t seen = 0;
+    for (const std::string& value : sv) {
+        assert(std::stoi(value.substr(value.find('-') == std::string::npos ? 0 : 7)) % 2 == 1
+            || value.find("reused") != std::string::npos);
+        ++seen;
+    }
+    assert(seen == sv.Size() && seen == 250);
+
+    // Копия компактна и независима; перемещение не трогает элементы
+    StableVector<std::string, 64> copy(sv);
+    assert(copy.Size() == sv.Size());
+    copy.Emplace("only-in-copy");
+    assert(copy.Size() == sv.Size() + 1);
+    const std::string* probe = &*sv.begin();
+    StableVector<std::string, 64> moved(std::move(sv));
+    assert(&*moved.begin() == probe && moved.Size() == 250);
+}
+
+void Test28() {
+    // Запись {ts, px, qty, venue}, разложенная по полосам
+    SoaVector<int64_t, double, double, int32_t> quotes;
+    quotes.Reserve(100);
+    for (int i = 0; i < 1000; ++i) {
+        quotes.PushBack(int64_t{1000} + i, 100.0 + i, 10.0 * i, i % 4);
+    }
+    assert(quotes.Size() == 1000);
+
+    // Прокси-ссылка читает и пишет поля одной логической записи
+    auto row = quotes[500];
+    assert(std::get<0>(row) == 1500 && std::get<3>(row) == 0);
+    std::get<1>(row) = -1.0;
+    assert(std::get<1>(quotes[500]) == -1.0);
+    auto [ts, px, qty, venue] = quotes.GetRow(7);
+    assert(ts == 1007 && px == 107.0 && qty == 70.0 && venue == 3);
+
+    // Полосы непрерывны: скан одного поля не тянет соседние
+    const double* px_lane = quotes.LaneData<1>();
+    double sum = 0.0;
+    for (size_t i = 0; i < quotes.Size(); ++i) {
+        sum += px_lane[i];
+    }
+    assert(sum > 0.0 && quotes.Lane<1>().Size() == quotes.Size());
+    assert(quotes.Lane<0>().begin() + 1000 == quotes.Lane<0>().end());
+
+    // Resize/PopBack/EmplaceBack держат полосы одной длины
+    quotes.Resize(1500);
+    assert(quotes.Lane<3>().Size() == 1500);
+    quotes.PopBack();
+    auto last = quotes.EmplaceBack(int64_t{9}, 9.0, 9.0, 9);
+    assert(std::get<0>(last) == 9 && quotes.Size() == 1500);
+
+    // Кортеж значений принимается как готовая запись
+    quotes.PushBack(std::tuple{int64_t{11}, 11.0, 11.0, 11});
+    assert(std::get<3>(quotes[quotes.Size() - 1]) == 11);
+
+    // При исключении в одной полосе остальные откатываются
+    SoaVector<Obj, int> fragile;
+    Obj::ResetCounters();
+    fragile.PushBack(Obj{1}, 1);
+    Obj throwing{2};
+    throwing.throw_on_copy = true;
+    try {
+        fragile.PushBack(throwing, 2);
+        assert(false && "Exception is expected");
+    }
+    catch (const std::runtime_error&) {
+    }
+    assert(fragile.Size() == 1 && fragile.Lane<1>().Size() == 1);
+}
+
+void Test29() {
+    // Бит на элемент: проверка против эталонного std::vector<bool>
+    BitVector bits;
+    std::vector<bool> ref;
+    for (int i = 0; i < 1000; ++i) {
+        const bool value = (i * 7) % 3 == 0;
+        bits.PushBack(value);
+        ref.push_back(value);
+    }
+    assert(bits.Size() == 1000);
+    for (size_t i = 0; i < bits.Size(); ++i) {
+        assert(bits[i] == ref[i]);
+    }
+    assert(bits.CountOnes() == static_cast<size_t>(std::count(ref.begin(), ref.end(), true)));
+
+    // Прокси-ссылка и пословный поиск
+    bits[500] = !bits[500];
+    bits[501].Flip();
+    BitVector zeros(130);
+    assert(zeros.CountOnes() == 0 && zeros.FindNext(true) == BitVector::NPOS);
+    zeros[128] = true;
+    assert(zeros.FindNext(true) == 128 && zeros.FindNext(false, 128) == 129);
+    zeros.Resize(256, true);
+    assert(zeros.CountOnes() == 1 + (256 - 130));
+    zeros.Resize(100);
+    assert(zeros.CountOnes() == 0 && zeros.Size() == 100);
+
+    // Итераторы совместимы с алгоритмами
+    assert(std::count(bits.cbegin(), bits.cend(), true) == static_cast<std::ptrdiff_t>(bits.CountOnes()));
+    auto found = std::find(zeros.begin(), zeros.end(), true);
+    assert(found == zeros.end());
+
+    // 12-битные значения пересекают границы слов
+    PackedVector<12> packed;
+    for (uint64_t i = 0; i < 500; ++i) {
+        packed.PushBack(i * 8u + 1u);
+    }
+    assert(packed.Size() == 500 && PackedVector<12>::MAX_VALUE == 4095);
+    for (uint64_t i = 0; i < 500; ++i) {
+        assert(packed[i] == i * 8u + 1u);
+    }
+    packed[100] = 4095;
+    packed[101] = 4096;  // обрезается маской
+    assert(packed[100] == 4095 && packed[101] == 0 && packed[99] == 99 * 8 + 1 && packed[102] == 102 * 8 + 1);
+
+    // Массовое кодирование/декодирование
+    uint16_t raw[257];
+    for (size_t i = 0; i < 257; ++i) {
+        raw[i] = static_cast<uint16_t>(i * 13u % 4096u);
+    }
+    packed.Encode(raw, 257);
+    assert(packed.Size() == 257);
+    uint16_t decoded[257] = {};
+    packed.Decode(decoded, 0, 257);
+    assert(std::equal(raw, raw + 257, decoded));
+    assert(*packed.begin() == 0 && packed.end() - packed.begin() == 257);
+
+    // Итераторы PackedVector — полноценный random access
+    PackedVector<12> sorted;
+    for (uint64_t i = 0; i < 300; ++i) {
+        sorted.PushBack(i * 3u);
+    }
+    auto lower = std::lower_bound(sorted.cbegin(), sorted.cend(), uint64_t{150});
+    assert(lower - sorted.cbegin() == 50 && *lower == 150);
+    auto it = sorted.begin() + 10;
+    it -= 4;
+    assert(it[0] == 18 && *(3 + it) == 27 && *(it - 2) == 12);
+    --it;
+    it++;
+    assert(it - sorted.begin() == 6);
+    assert(sorted.begin() < sorted.end() && sorted.begin() <= sorted.cbegin()
+        && sorted.end() > sorted.cbegin() && sorted.end() >= sorted.end());
+
+    // 2 бита: плотность 32 значения на слово
+    PackedVector<2> flags;
+    for (uint64_t i = 0; i < 100; ++i) {
+        flags.PushBack(i % 4u);
+    }
+    assert(flags[97] == 1 && flags[98] == 2 && flags[99] == 3);
+}
+
+void Test30() {
+    // Порядок и поиск сверяются с эталонным std::vector
+    SortedVector<int64_t> index;
+    std::vector<int64_t> ref;
+    uint64_t state = 42;
+    for (int i = 0; i < 5000; ++i) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        const int64_t key = static_cast<int64_t>(state % 1000);
+        index.Insert(key);
+        ref.push_back(key);
+    }
+    assert(index.Size() == ref.size());
+    std::sort(ref.begin(), ref.end());
+    assert(std::equal(index.begin(), index.end(), ref.begin()));
+    for (int64_t key = -1; key <= 1000; ++key) {
+        const auto expected = std::lower_bound(ref.begin(), ref.end(), key) - ref.begin();
+        assert(index.LowerBound(key) - index.begin() == expected);
+        const auto expected_upper = std::upper_bound(ref.begin(), ref.end(), key) - ref.begin();
+        assert(index.UpperBound(key) - index.begin() == expected_upper);
+        assert(index.Contains(key) == std::binary_search(ref.begin(), ref.end(), key));
+    }
+
+    // Вставки копятся в буфере и вливаются одним слиянием
+    SortedVector<int> lazy;
+    for (int i = 0; i < 10; ++i) {
+        lazy.Insert(10 - i);
+    }
+    assert(lazy.PendingCount() == 10 && lazy.Size() == 10);
+    assert(*lazy.begin() == 1 && lazy.PendingCount() == 0);
+
+    // Массовое слияние диапазона и дубликаты
+    const int batch[] = {5, 3, 5, 100, -7};
+    lazy.MergeFrom(std::begin(batch), std::end(batch));
+    assert(lazy.Size() == 15 && lazy[0] == -7 && lazy[14] == 100);
+    assert(lazy.UpperBound(5) - lazy.LowerBound(5) == 3);
+
+    // Пользовательский компаратор: убывающий индекс
+    SortedVector<std::string, std::greater<std::string>> desc;
+    desc.Insert("b");
+    desc.Insert("c");
+    desc.Insert("a");
+    assert(desc[0] == "c" && desc[2] == "a");
+    assert(desc.Find("b") != desc.end() && desc.Find("z") == desc.end());
+}
+
+void Test31() {
+    // Фиксированная ёмкость: вся жизнь — во встроенном буфере
+    FixedVector<std::string, 8> names;
+    assert(names.Capacity() == 8 && names.Empty());
+    for (int i = 0; i < 8; ++i) {
+        names.PushBack("name-" + std::to_string(i));
+    }
+    assert(names.Full() && names[7] == "name-7");
+    const std::string* stable = &names[0];
+    names.PopBack();
+    names.EmplaceBack("replacement");
+    assert(&names[0] == stable && names[7] == "replacement");
+
+    // THROW: переполнение — немедленная ошибка, состояние не меняется
+    FixedVector<int, 4, OverflowPolicy::THROW> strict(4);
+    try {
+        strict.PushBack(5);
+        assert(false && "Exception is expected");
+    }
+    catch (const std::length_error&) {
+    }
+    assert(strict.Size() == 4);
+    try {
+        strict.Resize(10);
+        assert(false && "Exception is expected");
+    }
+    catch (const std::length_error&) {
+    }
+
+    // DROP: лишние элементы молча отбрасываются; TryPushBack сообщает явно
+    FixedVector<int, 4, OverflowPolicy::DROP> ring;
+    for (int i = 0; i < 10; ++i) {
+        ring.PushBack(i);
+    }
+    assert(ring.Size() == 4 && ring[3] == 3);
+    assert(!ring.TryPushBack(99));
+    ring.PopBack();
+    assert(ring.TryPushBack(99) && ring[3] == 99);
+
+    // Копирование и перемещение сохраняют содержимое
+    FixedVector<std::string, 8> names_copy(names);
+    assert(names_copy.Size() == 8 && names_copy[0] == names[0]);
+    FixedVector<std::string, 8> names_moved(std::move(names_copy));
+    assert(names_moved[7] == "replacement");
+
+    // LockCapacity: рост внутри ёмкости разрешён, реаллокация — ошибка
+    Vector<int> rt;
+    rt.Reserve(100);
+    rt.LockCapacity();
+    assert(rt.IsCapacityLocked());
+    for (int i = 0; i < 100; ++i) {
+        rt.PushBack(i);
+    }
+    assert(rt.Size() == 100 && rt.Capacity() == 100);
+    try {
+        rt.PushBack(100);
+        assert(false && "Exception is expected");
+    }
+    catch (const std::length_error&) {
+    }
+    assert(rt.Size() == 100 && rt[99] == 99);
+    try {
+        rt.Insert(rt.cbegin(), 1);
+        assert(false && "Exception is expected");
+    }
+    catch (const std::length_error&) {
+    }
+    try {
+        rt.ShrinkToFit();
+        rt.Reserve(200);
+        assert(false && "Exception is expected");
+    }
+    catch (const std::length_error&) {
+    }
+    rt.PopBack();
+    rt.PushBack(7);
+    assert(rt[99] == 7);
+    rt.UnlockCapacity();
+    rt.Reserve(200);
+    assert(rt.Capacity() == 200);
+
+    // Перемещение переносит замок вместе с буфером
+    rt.LockCapacity();
+    Vector<int> rt_moved(std::move(rt));
+    assert(rt_moved.IsCapacityLocked() && !rt.IsCapacityLocked());
+}
+
 struct C {
     C() noexcept {
         ++def_ctor;
@@ -654,6 +2002,31 @@ int main() {
         Test4();
         Test5();
         Test6();
+        Test7();
+        Test8();
+        Test9();
+        Test10();
+        Test11();
+        Test12();
+        Test13();
+        Test14();
+        Test15();
+        Test16();
+        Test17();
+        Test18();
+        Test19();
+        Test20();
+        Test21();
+        Test22();
+        Test23();
+        Test24();
+        Test25();
+        Test26();
+        Test27();
+        Test28();
+        Test29();
+        Test30();
+        Test31();
         Benchmark();
     }
     catch (const std::exception& e) {
@@ -0,0 +1,159 @@
+﻿#pragma once
+#include "vector.h"
+
+#include <cstdint>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Формат файла: 64-байтовый заголовок (магия, размер элемента, число элементов,
+// всё в little-endian), затем сырые байты элементов. Заголовок дополнен до 64 байт,
+// чтобы данные были выровнены для любых типов элементов
+struct MappedVectorHeader {
+	static const uint64_t MAGIC = 0x30524F5443455656ull;  // "VVECTOR0"
+
+	uint64_t magic = MAGIC;
+	uint64_t elem_size = 0;
+	uint64_t size = 0;
+	uint64_t reserved[5] = {};
+};
+
+static_assert(sizeof(MappedVectorHeader) == 64, "header must pad data to a 64-byte boundary");
+
+// Записывает буфер целиком, переживая короткие записи
+inline bool WriteAll(int fd, const void* buf, size_t bytes) {
+	const char* ptr = static_cast<const char*>(buf);
+	while (bytes > 0) {
+		const ssize_t written = ::write(fd, ptr, bytes);
+		if (written <= 0) {
+			return false;
+		}
+		ptr += written;
+		bytes -= static_cast<size_t>(written);
+	}
+	return true;
+}
+
+// Сохраняет вектор тривиально копируемых элементов в файл одной bulk-записью
+template <typename T, typename Alloc, typename Growth>
+void FlushToFile(const Vector<T, Alloc, Growth>& v, const char* path) {
+	static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements have a defined on-disk layout");
+	const int fd = ::open(path, O_CREAT | O_TRUNC | O_WRONLY, 0644);
+	if (fd < 0) {
+		throw std::runtime_error("FlushToFile: cannot open file");
+	}
+	MappedVectorHeader header;
+	header.elem_size = sizeof(T);
+	header.size = v.Size();
+	bool ok = WriteAll(fd, &header, sizeof(header));
+	ok = ok && WriteAll(fd, v.Data(), v.Size() * sizeof(T));
+	::close(fd);
+	if (!ok) {
+		throw std::runtime_error("FlushToFile: write failed");
+	}
+}
+
+// Снимок вектора, отображённый из файла: открывается за миллисекунды благодаря
+// demand paging и может разделяться несколькими процессами только для чтения
+template <typename T>
+class MappedVector {
+	static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements can be mapped");
+
+public:
+	using const_iterator = const T*;
+
+	MappedVector() = default;
+
+	explicit MappedVector(const char* path) {
+		const int fd = ::open(path, O_RDONLY);
+		if (fd < 0) {
+			throw std::runtime_error("MappedVector: cannot open file");
+		}
+		struct stat st {};
+		if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(MappedVectorHeader)) {
+			::close(fd);
+			throw std::runtime_error("MappedVector: truncated file");
+		}
+		mapped_bytes_ = static_cast<size_t>(st.st_size);
+		void* mapping = ::mmap(nullptr, mapped_bytes_, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (mapping == MAP_FAILED) {
+			throw std::runtime_error("MappedVector: mmap failed");
+		}
+		mapping_ = mapping;
+		const auto* header = static_cast<const MappedVectorHeader*>(mapping);
+		if (header->magic != MappedVectorHeader::MAGIC || header->elem_size != sizeof(T)
+			|| mapped_bytes_ < sizeof(MappedVectorHeader) + header->size * sizeof(T)) {
+			Unmap();
+			throw std::runtime_error("MappedVector: header mismatch");
+		}
+		size_ = header->size;
+	}
+
+	MappedVector(const MappedVector&) = delete;
+
+	MappedVector& operator=(const MappedVector&) = delete;
+
+	MappedVector(MappedVector&& other) noexcept
+		: mapping_(std::exchange(other.mapping_, nullptr))
+		, mapped_bytes_(std::exchange(other.mapped_bytes_, 0))
+		, size_(std::exchange(other.size_, 0)) {
+	}
+
+	MappedVector& operator=(MappedVector&& rhs) noexcept {
+		if (this != &rhs) {
+			Unmap();
+			mapping_ = std::exchange(rhs.mapping_, nullptr);
+			mapped_bytes_ = std::exchange(rhs.mapped_bytes_, 0);
+			size_ = std::exchange(rhs.size_, 0);
+		}
+		return *this;
+	}
+
+	~MappedVector() {
+		Unmap();
+	}
+
+	size_t Size() const noexcept {
+		return size_;
+	}
+
+	const T& operator[](size_t index) const noexcept {
+		assert(index < size_);
+		return begin()[index];
+	}
+
+	const_iterator begin() const noexcept {
+		return reinterpret_cast<const T*>(static_cast<const unsigned char*>(mapping_) + sizeof(MappedVectorHeader));
+	}
+
+	const_iterator end() const noexcept {
+		return begin() + size_;
+	}
+
+	// Полная копия в обычный (изменяемый) Vector
+	Vector<T> ToVector() const {
+		Vector<T> result;
+		result.AppendBack(begin(), end());
+		return result;
+	}
+
+private:
+	void Unmap() noexcept {
+		if (mapping_ != nullptr) {
+			::munmap(mapping_, mapped_bytes_);
+			mapping_ = nullptr;
+		}
+	}
+
+	void* mapping_ = nullptr;
+	size_t mapped_bytes_ = 0;
+	size_t size_ = 0;
+};
+
+#endif  // defined(__unix__) || defined(__APPLE__)
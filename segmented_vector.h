@@ -0,0 +1,250 @@
+﻿#pragma once
+#include "vector.h"
+
+// Вектор с сегментированным хранилищем: элементы лежат в блоках фиксированного
+// размера, на которые ссылается индексный массив. Сегмент, однажды выделенный,
+// никогда не перемещается, поэтому PushBack — O(1) в худшем случае: нет блочного
+// переноса всех элементов на границе ёмкости, а значит и латентных пиков на ней.
+// Адреса элементов стабильны на всё время жизни. Плата — одна дополнительная
+// индирекция при доступе по индексу
+template <typename T, size_t SEGMENT_CAPACITY = 1024, typename Alloc = NewDeleteAllocator<T>>
+class SegmentedVector {
+	static_assert((SEGMENT_CAPACITY & (SEGMENT_CAPACITY - 1)) == 0,
+		"SEGMENT_CAPACITY must be a power of two");
+
+	template <bool IS_CONST>
+	class BasicIterator;
+
+public:
+	using iterator = BasicIterator<false>;
+	using const_iterator = BasicIterator<true>;
+
+	SegmentedVector() = default;
+
+	SegmentedVector(const SegmentedVector& other)
+		: alloc_(other.alloc_) {
+		for (size_t i = 0; i < other.size_; ++i) {
+			PushBack(other[i]);
+		}
+	}
+
+	SegmentedVector& operator=(const SegmentedVector& rhs) {
+		if (this != &rhs) {
+			SegmentedVector rhs_copy(rhs);
+			Swap(rhs_copy);
+		}
+		return *this;
+	}
+
+	SegmentedVector(SegmentedVector&& other) noexcept
+		: alloc_(std::move(other.alloc_))
+		, segments_(std::move(other.segments_))
+		, size_(std::exchange(other.size_, 0)) {
+	}
+
+	SegmentedVector& operator=(SegmentedVector&& rhs) noexcept {
+		Swap(rhs);
+		return *this;
+	}
+
+	~SegmentedVector() {
+		for (size_t i = 0; i < size_; ++i) {
+			std::destroy_at(&ElementAt(i));
+		}
+		for (size_t seg = 0; seg < segments_.Size(); ++seg) {
+			alloc_.Deallocate(segments_[seg], SEGMENT_CAPACITY);
+		}
+	}
+
+	size_t Size() const noexcept {
+		return size_;
+	}
+
+	size_t Capacity() const noexcept {
+		return segments_.Size() * SEGMENT_CAPACITY;
+	}
+
+	template <typename... Args>
+	T& EmplaceBack(Args&&... args) {
+		if (size_ == Capacity()) {
+			// Растёт только индексный массив; уже заполненные сегменты не трогаются
+			segments_.PushBack(alloc_.Allocate(SEGMENT_CAPACITY));
+		}
+		T* slot = &ElementAt(size_);
+		new (slot) T(std::forward<Args>(args)...);
+		++size_;
+		return *slot;
+	}
+
+	void PushBack(const T& value) {
+		EmplaceBack(value);
+	}
+
+	void PushBack(T&& value) {
+		EmplaceBack(std::move(value));
+	}
+
+	void PopBack() {
+		std::destroy_at(&ElementAt(size_ - 1));
+		--size_;
+	}
+
+	const T& operator[](size_t index) const noexcept {
+		return const_cast<SegmentedVector&>(*this)[index];
+	}
+
+	T& operator[](size_t index) noexcept {
+		assert(index < size_);
+		return ElementAt(index);
+	}
+
+	void Swap(SegmentedVector& other) noexcept {
+		segments_.Swap(other.segments_);
+		std::swap(alloc_, other.alloc_);
+		std::swap(size_, other.size_);
+	}
+
+	iterator begin() noexcept {
+		return iterator{this, 0};
+	}
+
+	iterator end() noexcept {
+		return iterator{this, size_};
+	}
+
+	const_iterator begin() const noexcept {
+		return const_iterator{this, 0};
+	}
+
+	const_iterator end() const noexcept {
+		return const_iterator{this, size_};
+	}
+
+private:
+	template <bool IS_CONST>
+	class BasicIterator {
+		friend class SegmentedVector;
+
+		template <bool OTHER_CONST>
+		friend class BasicIterator;
+
+		using Owner = std::conditional_t<IS_CONST, const SegmentedVector, SegmentedVector>;
+
+	public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<IS_CONST, const T*, T*>;
+		using reference = std::conditional_t<IS_CONST, const T&, T&>;
+
+		BasicIterator() = default;
+
+		// Неконстантный итератор неявно приводится к константному
+		template <bool C = IS_CONST, typename = std::enable_if_t<C>>
+		BasicIterator(const BasicIterator<false>& other) noexcept
+			: owner_(other.owner_)
+			, index_(other.index_) {
+		}
+
+		reference operator*() const noexcept {
+			return (*owner_)[index_];
+		}
+
+		pointer operator->() const noexcept {
+			return &(*owner_)[index_];
+		}
+
+		reference operator[](difference_type offset) const noexcept {
+			return (*owner_)[index_ + offset];
+		}
+
+		BasicIterator& operator++() noexcept {
+			++index_;
+			return *this;
+		}
+
+		BasicIterator operator++(int) noexcept {
+			BasicIterator copy(*this);
+			++index_;
+			return copy;
+		}
+
+		BasicIterator& operator--() noexcept {
+			--index_;
+			return *this;
+		}
+
+		BasicIterator operator--(int) noexcept {
+			BasicIterator copy(*this);
+			--index_;
+			return copy;
+		}
+
+		BasicIterator& operator+=(difference_type offset) noexcept {
+			index_ += static_cast<size_t>(offset);
+			return *this;
+		}
+
+		BasicIterator& operator-=(difference_type offset) noexcept {
+			index_ -= static_cast<size_t>(offset);
+			return *this;
+		}
+
+		friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+			return it += offset;
+		}
+
+		friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+			return it += offset;
+		}
+
+		friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+			return it -= offset;
+		}
+
+		friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+			return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+		}
+
+		friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+			return lhs.index_ == rhs.index_;
+		}
+
+		friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+			return !(lhs == rhs);
+		}
+
+		friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+			return lhs.index_ < rhs.index_;
+		}
+
+		friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+			return rhs < lhs;
+		}
+
+		friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+			return !(rhs < lhs);
+		}
+
+		friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+			return !(lhs < rhs);
+		}
+
+	private:
+		BasicIterator(Owner* owner, size_t index) noexcept
+			: owner_(owner)
+			, index_(index) {
+		}
+
+		Owner* owner_ = nullptr;
+		size_t index_ = 0;
+	};
+
+	T& ElementAt(size_t index) noexcept {
+		return segments_[index / SEGMENT_CAPACITY][index % SEGMENT_CAPACITY];
+	}
+
+	Alloc alloc_{};
+	Vector<T*> segments_;
+	size_t size_ = 0;
+};
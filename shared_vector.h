@@ -0,0 +1,149 @@
+﻿#pragma once
+#include "vector.h"
+
+#include <atomic>
+
+// Вектор с разделяемым буфером и копированием при записи. Снимок (Snapshot или
+// копирование) — O(1): увеличивается счётчик ссылок на общий управляющий блок.
+// Глубокая копия происходит только при первой мутации, когда буфер разделён
+// с кем-то ещё, поэтому раздача снимков десяткам потоков-читателей бесплатна.
+//
+// Потокобезопасность — как у shared_ptr: счётчик атомарный, снимки можно
+// передавать и разрушать из разных потоков, но сам снимок и мутирующие вызовы
+// требуют внешней синхронизации
+template <typename T, typename Alloc = NewDeleteAllocator<T>, typename Growth = GrowthX2>
+class SharedVector {
+public:
+	using const_iterator = typename Vector<T, Alloc, Growth>::const_iterator;
+
+	SharedVector()
+		: block_(new ControlBlock{}) {
+	}
+
+	explicit SharedVector(Vector<T, Alloc, Growth> data)
+		: block_(new ControlBlock{std::move(data)}) {
+	}
+
+	SharedVector(const SharedVector& other) noexcept
+		: block_(other.block_) {
+		block_->ref_count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	SharedVector& operator=(const SharedVector& rhs) noexcept {
+		if (block_ != rhs.block_) {
+			Release();
+			block_ = rhs.block_;
+			block_->ref_count.fetch_add(1, std::memory_order_relaxed);
+		}
+		return *this;
+	}
+
+	SharedVector(SharedVector&& other) noexcept
+		: block_(std::exchange(other.block_, nullptr)) {
+	}
+
+	SharedVector& operator=(SharedVector&& rhs) noexcept {
+		if (this != &rhs) {
+			Release();
+			block_ = std::exchange(rhs.block_, nullptr);
+		}
+		return *this;
+	}
+
+	~SharedVector() {
+		Release();
+	}
+
+	// O(1)-снимок текущего содержимого; дальнейшие мутации оригинала его не затронут
+	SharedVector Snapshot() const noexcept {
+		return *this;
+	}
+
+	// Число владельцев общего буфера (включая этот объект)
+	size_t UseCount() const noexcept {
+		return block_->ref_count.load(std::memory_order_relaxed);
+	}
+
+	size_t Size() const noexcept {
+		return block_->data.Size();
+	}
+
+	size_t Capacity() const noexcept {
+		return block_->data.Capacity();
+	}
+
+	const T& operator[](size_t index) const noexcept {
+		return block_->data[index];
+	}
+
+	const_iterator begin() const noexcept {
+		return block_->data.begin();
+	}
+
+	const_iterator end() const noexcept {
+		return block_->data.end();
+	}
+
+	// Мутирующие операции: перед записью буфер отделяется, если он разделён
+
+	T& operator[](size_t index) {
+		Detach();
+		return block_->data[index];
+	}
+
+	void PushBack(const T& value) {
+		Detach();
+		block_->data.PushBack(value);
+	}
+
+	void PushBack(T&& value) {
+		Detach();
+		block_->data.PushBack(std::move(value));
+	}
+
+	template <typename... Args>
+	T& EmplaceBack(Args&&... args) {
+		Detach();
+		return block_->data.EmplaceBack(std::forward<Args>(args)...);
+	}
+
+	void PopBack() {
+		Detach();
+		block_->data.PopBack();
+	}
+
+	void Resize(size_t new_size) {
+		Detach();
+		block_->data.Resize(new_size);
+	}
+
+	void Reserve(size_t new_capacity) {
+		Detach();
+		block_->data.Reserve(new_capacity);
+	}
+
+private:
+	struct ControlBlock {
+		Vector<T, Alloc, Growth> data{};
+		std::atomic<size_t> ref_count{1};
+	};
+
+	// Единоличный владелец пишет на месте; разделённый буфер сперва копируется
+	void Detach() {
+		if (block_->ref_count.load(std::memory_order_acquire) == 1) {
+			return;
+		}
+		ControlBlock* fresh = new ControlBlock{block_->data};
+		Release();
+		block_ = fresh;
+	}
+
+	void Release() noexcept {
+		if (block_ != nullptr && block_->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			delete block_;
+		}
+		block_ = nullptr;
+	}
+
+	ControlBlock* block_ = nullptr;
+};
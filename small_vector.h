@@ -0,0 +1,187 @@
+﻿#pragma once
+#include "vector.h"
+
+// Вектор с малым буфером: до N элементов хранятся внутри самого объекта,
+// куча задействуется только после переполнения встроенного хранилища
+template <typename T, size_t N, typename Alloc = NewDeleteAllocator<T>>
+class SmallVector {
+public:
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	SmallVector() = default;
+
+	explicit SmallVector(Alloc alloc) noexcept
+		: heap_(std::move(alloc)) {
+	}
+
+	explicit SmallVector(size_t size, Alloc alloc = Alloc{})
+		: heap_(std::move(alloc)) {
+		Reserve(size);
+		std::uninitialized_value_construct_n(Data(), size);
+		size_ = size;
+	}
+
+	SmallVector(const SmallVector& other)
+		: heap_(other.heap_.GetAllocator()) {
+		Reserve(other.size_);
+		std::uninitialized_copy_n(other.Data(), other.size_, Data());
+		size_ = other.size_;
+	}
+
+	SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		TakeContent(other);
+	}
+
+	~SmallVector() {
+		std::destroy_n(Data(), size_);
+	}
+
+	SmallVector& operator=(const SmallVector& rhs) {
+		if (this != &rhs) {
+			*this = SmallVector(rhs);
+		}
+		return *this;
+	}
+
+	SmallVector& operator=(SmallVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		if (this != &rhs) {
+			std::destroy_n(Data(), size_);
+			size_ = 0;
+			TakeContent(rhs);
+		}
+		return *this;
+	}
+
+	iterator begin() noexcept {
+		return Data();
+	}
+
+	iterator end() noexcept {
+		return Data() + size_;
+	}
+
+	const_iterator begin() const noexcept {
+		return Data();
+	}
+
+	const_iterator end() const noexcept {
+		return Data() + size_;
+	}
+
+	const_iterator cbegin() const noexcept {
+		return begin();
+	}
+
+	const_iterator cend() const noexcept {
+		return end();
+	}
+
+	size_t Size() const noexcept {
+		return size_;
+	}
+
+	size_t Capacity() const noexcept {
+		return IsSpilled() ? heap_.Capacity() : N;
+	}
+
+	// Сообщает, перешёл ли вектор из встроенного хранилища на кучу
+	bool IsSpilled() const noexcept {
+		return heap_.Capacity() != 0;
+	}
+
+	const Alloc& GetAllocator() const noexcept {
+		return heap_.GetAllocator();
+	}
+
+	const T& operator[](size_t index) const noexcept {
+		return const_cast<SmallVector&>(*this)[index];
+	}
+
+	T& operator[](size_t index) noexcept {
+		assert(index < size_);
+		return Data()[index];
+	}
+
+	void Reserve(size_t new_capacity) {
+		if (new_capacity <= Capacity()) {
+			return;
+		}
+		RawMemory<T, Alloc> new_data(new_capacity, heap_.GetAllocator());
+		RelocateAndSwap(new_data);
+	}
+
+	void PushBack(const T& value) {
+		EmplaceBack(value);
+	}
+
+	void PushBack(T&& value) {
+		EmplaceBack(std::move(value));
+	}
+
+	void PopBack() {
+		std::destroy_at(Data() + size_ - 1);
+		--size_;
+	}
+
+	template <typename... Args>
+	T& EmplaceBack(Args&&... args) {
+		if (size_ == Capacity()) {
+			RawMemory<T, Alloc> new_data(size_ * 2, heap_.GetAllocator());
+			new (new_data + size_) T(std::forward<Args>(args)...);
+			RelocateAndSwap(new_data);
+		}
+		else {
+			new (Data() + size_) T(std::forward<Args>(args)...);
+		}
+		++size_;
+		return Data()[size_ - 1];
+	}
+
+private:
+	T* Data() noexcept {
+		return IsSpilled() ? heap_.GetAddress() : reinterpret_cast<T*>(inline_buf_);
+	}
+
+	const T* Data() const noexcept {
+		return const_cast<SmallVector&>(*this).Data();
+	}
+
+	// Переносит элементы в new_data и делает её текущим хранилищем (см. Vector::CopyOrMoveAndSwap)
+	void RelocateAndSwap(RawMemory<T, Alloc>& new_data) {
+		if constexpr (IsTriviallyRelocatableV<T>) {
+			if (size_ != 0) {
+				std::memcpy(static_cast<void*>(new_data.GetAddress()), Data(), size_ * sizeof(T));
+			}
+		}
+		else if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+			std::uninitialized_move_n(Data(), size_, new_data.GetAddress());
+			std::destroy_n(Data(), size_);
+		}
+		else {
+			std::uninitialized_copy_n(Data(), size_, new_data.GetAddress());
+			std::destroy_n(Data(), size_);
+		}
+		heap_.Swap(new_data);
+	}
+
+	// Забирает содержимое other: буфер на куче крадётся, встроенный переносится поэлементно
+	void TakeContent(SmallVector& other) {
+		if (other.IsSpilled()) {
+			heap_ = std::move(other.heap_);
+			size_ = std::exchange(other.size_, 0);
+		}
+		else {
+			// Собственный буфер на куче освобождается, аллокатор переносится из other
+			heap_ = RawMemory<T, Alloc>(other.heap_.GetAllocator());
+			std::uninitialized_move_n(other.Data(), other.size_, Data());
+			size_ = other.size_;
+			std::destroy_n(other.Data(), other.size_);
+			other.size_ = 0;
+		}
+	}
+
+	alignas(T) unsigned char inline_buf_[N * sizeof(T)];
+	RawMemory<T, Alloc> heap_;
+	size_t size_ = 0;
+};
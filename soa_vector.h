@@ -0,0 +1,158 @@
+﻿#pragma once
+#include "vector.h"
+
+#include <tuple>
+
+// Structure-of-arrays вектор: каждое поле записи хранится в собственной
+// непрерывной полосе (Vector), а не вперемешку в одной структуре. Ядра,
+// сканирующие одно поле, читают кэш-линии без балласта соседних полей,
+// а компилятор свободно векторизует проход по полосе. API повторяет Vector:
+// PushBack/EmplaceBack/Resize/operator[], но индекс возвращает прокси — кортеж
+// ссылок на поля одной логической записи
+//
+// Описание записи — список типов полей: SoaVector<int64_t, double, int32_t>
+// соответствует структуре {int64_t; double; int32_t}, разложенной по полосам
+template <typename... Fields>
+class SoaVector {
+	static_assert(sizeof...(Fields) > 0, "SoaVector requires at least one field");
+
+public:
+	// Кортеж значений одной записи и прокси-ссылки на её поля по полосам
+	using Row = std::tuple<Fields...>;
+	using Reference = std::tuple<Fields&...>;
+	using ConstReference = std::tuple<const Fields&...>;
+
+	SoaVector() = default;
+
+	size_t Size() const noexcept {
+		return std::get<0>(lanes_).Size();
+	}
+
+	size_t Capacity() const noexcept {
+		return std::get<0>(lanes_).Capacity();
+	}
+
+	void Reserve(size_t new_capacity) {
+		std::apply([new_capacity](auto&... lanes) {
+			(lanes.Reserve(new_capacity), ...);
+			}, lanes_);
+	}
+
+	void Resize(size_t new_size) {
+		const size_t old_size = Size();
+		size_t done = 0;
+#if VECTOR_HAS_EXCEPTIONS
+		try {
+			ResizeLanes(new_size, done, std::index_sequence_for<Fields...>{});
+		}
+		catch (...) {
+			// Уже выросшие полосы возвращаются к прежней длине — записи не рассинхронизируются
+			ResizeFirstLanes(old_size, done, std::index_sequence_for<Fields...>{});
+			throw;
+		}
+#else
+		ResizeLanes(new_size, done, std::index_sequence_for<Fields...>{});
+#endif
+	}
+
+	void PushBack(const Fields&... values) {
+		AppendRow(std::index_sequence_for<Fields...>{}, values...);
+	}
+
+	void PushBack(const Row& row) {
+		std::apply([this](const Fields&... values) {
+			PushBack(values...);
+			}, row);
+	}
+
+	template <typename... Args>
+	Reference EmplaceBack(Args&&... args) {
+		static_assert(sizeof...(Args) == sizeof...(Fields),
+			"EmplaceBack takes one argument per field");
+		AppendRow(std::index_sequence_for<Fields...>{}, std::forward<Args>(args)...);
+		return (*this)[Size() - 1];
+	}
+
+	void PopBack() noexcept {
+		std::apply([](auto&... lanes) {
+			(lanes.PopBack(), ...);
+			}, lanes_);
+	}
+
+	Reference operator[](size_t index) noexcept {
+		assert(index < Size());
+		return RowAt(index, std::index_sequence_for<Fields...>{});
+	}
+
+	ConstReference operator[](size_t index) const noexcept {
+		assert(index < Size());
+		return RowAt(index, std::index_sequence_for<Fields...>{});
+	}
+
+	// Собирает запись в кортеж значений (копия, независимая от контейнера)
+	Row GetRow(size_t index) const {
+		return Row((*this)[index]);
+	}
+
+	// Полоса поля I как контейнер — для чтения и поэлементного обхода
+	template <size_t I>
+	const auto& Lane() const noexcept {
+		return std::get<I>(lanes_);
+	}
+
+	// Непрерывный диапазон полосы I для SIMD-ядер; [LaneData, LaneData + Size)
+	template <size_t I>
+	auto* LaneData() noexcept {
+		return std::get<I>(lanes_).Data();
+	}
+
+	template <size_t I>
+	const auto* LaneData() const noexcept {
+		return std::get<I>(lanes_).Data();
+	}
+
+	void Swap(SoaVector& other) noexcept {
+		std::swap(lanes_, other.lanes_);
+	}
+
+private:
+	template <size_t... I, typename... Args>
+	void AppendRow(std::index_sequence<I...>, Args&&... args) {
+		size_t done = 0;
+#if VECTOR_HAS_EXCEPTIONS
+		try {
+			((std::get<I>(lanes_).EmplaceBack(std::forward<Args>(args)), ++done), ...);
+		}
+		catch (...) {
+			// Откат уже дополненных полос: длины всех полос всегда совпадают
+			((I < done ? std::get<I>(lanes_).PopBack() : void()), ...);
+			throw;
+		}
+#else
+		((std::get<I>(lanes_).EmplaceBack(std::forward<Args>(args)), ++done), ...);
+#endif
+	}
+
+	template <size_t... I>
+	void ResizeLanes(size_t new_size, size_t& done, std::index_sequence<I...>) {
+		((std::get<I>(lanes_).Resize(new_size), ++done), ...);
+	}
+
+	// Возвращает первые count полос к длине size; сжатие не бросает
+	template <size_t... I>
+	void ResizeFirstLanes(size_t size, size_t count, std::index_sequence<I...>) {
+		((I < count ? std::get<I>(lanes_).Resize(size) : void()), ...);
+	}
+
+	template <size_t... I>
+	Reference RowAt(size_t index, std::index_sequence<I...>) noexcept {
+		return std::tie(std::get<I>(lanes_)[index]...);
+	}
+
+	template <size_t... I>
+	ConstReference RowAt(size_t index, std::index_sequence<I...>) const noexcept {
+		return std::tie(std::get<I>(lanes_)[index]...);
+	}
+
+	std::tuple<Vector<Fields>...> lanes_;
+};
@@ -0,0 +1,169 @@
+﻿#pragma once
+#include "vector.h"
+
+#include <functional>
+
+// Адаптер отсортированного вектора поверх Vector: поиск — безветвевой бинарный
+// с предвыборкой, вставки копятся в буфере отложенных ключей и вливаются в
+// основу одним O(n + k) слиянием вместо O(n) сдвига на каждый ключ. Порог
+// автослива растёт с размером основы, так что сопровождение индекса стоит
+// амортизированно O(log n) на ключ. Дубликаты сохраняются (семантика multiset)
+template <typename T, typename Compare = std::less<T>>
+class SortedVector {
+public:
+	using const_iterator = const T*;
+
+	SortedVector() = default;
+
+	explicit SortedVector(Compare cmp)
+		: cmp_(std::move(cmp)) {
+	}
+
+	size_t Size() const noexcept {
+		return base_.Size() + staging_.Size();
+	}
+
+	bool Empty() const noexcept {
+		return Size() == 0;
+	}
+
+	// Число ключей, ещё не влитых в отсортированную основу
+	size_t PendingCount() const noexcept {
+		return staging_.Size();
+	}
+
+	void Reserve(size_t new_capacity) {
+		base_.Reserve(new_capacity);
+	}
+
+	// O(1) амортизированно: ключ попадает в буфер, слияние — при переполнении буфера
+	void Insert(const T& value) {
+		staging_.PushBack(value);
+		FlushIfFull();
+	}
+
+	void Insert(T&& value) {
+		staging_.PushBack(std::move(value));
+		FlushIfFull();
+	}
+
+	// Массовая вставка диапазона одним слиянием
+	template <typename InputIt>
+	void MergeFrom(InputIt first, InputIt last) {
+		staging_.AppendBack(first, last);
+		Flush();
+	}
+
+	// Вливает отложенные ключи в основу: сортировка буфера + один проход слияния
+	void Flush() {
+		if (staging_.Size() == 0) {
+			return;
+		}
+		std::sort(staging_.Data(), staging_.Data() + staging_.Size(), cmp_);
+		Vector<T> merged;
+		merged.Reserve(base_.Size() + staging_.Size());
+		T* base_it = base_.Data();
+		T* const base_end = base_.Data() + base_.Size();
+		T* staging_it = staging_.Data();
+		T* const staging_end = staging_.Data() + staging_.Size();
+		while (base_it != base_end && staging_it != staging_end) {
+			// Равные ключи — сначала из основы: слияние стабильно
+			if (cmp_(*staging_it, *base_it)) {
+				merged.PushBack(std::move(*staging_it));
+				++staging_it;
+			}
+			else {
+				merged.PushBack(std::move(*base_it));
+				++base_it;
+			}
+		}
+		merged.AppendBack(std::make_move_iterator(base_it), std::make_move_iterator(base_end));
+		merged.AppendBack(std::make_move_iterator(staging_it), std::make_move_iterator(staging_end));
+		base_.Swap(merged);
+		staging_ = Vector<T>{};
+	}
+
+	// Первый элемент не меньше value; безветвевой поиск по влитой основе
+	const_iterator LowerBound(const T& value) {
+		Flush();
+		return BranchFreeBound(value, [this](const T& element, const T& key) {
+			return cmp_(element, key);
+			});
+	}
+
+	// Первый элемент больше value
+	const_iterator UpperBound(const T& value) {
+		Flush();
+		return BranchFreeBound(value, [this](const T& element, const T& key) {
+			return !cmp_(key, element);
+			});
+	}
+
+	const_iterator Find(const T& value) {
+		const_iterator pos = LowerBound(value);
+		return pos != end() && !cmp_(value, *pos) ? pos : end();
+	}
+
+	bool Contains(const T& value) {
+		return Find(value) != end();
+	}
+
+	// Доступ по рангу; вливает отложенные ключи
+	const T& operator[](size_t index) {
+		Flush();
+		assert(index < base_.Size());
+		return base_[index];
+	}
+
+	const_iterator begin() {
+		Flush();
+		return base_.Data();
+	}
+
+	const_iterator end() {
+		Flush();
+		return base_.Data() + base_.Size();
+	}
+
+private:
+	static void Prefetch(const T* ptr) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+		__builtin_prefetch(ptr);
+#else
+		(void)ptr;
+#endif
+	}
+
+	// Классический безветвевой нижний поиск: шаг выбирается условной пересылкой,
+	// а обе возможные середины следующей итерации подтягиваются заранее
+	template <typename AdvancePred>
+	const T* BranchFreeBound(const T& key, AdvancePred advance) const noexcept {
+		const T* first = base_.Data();
+		size_t count = base_.Size();
+		if (count == 0) {
+			return first;
+		}
+		while (count > 1) {
+			const size_t half = count / 2;
+			Prefetch(first + half / 2);
+			Prefetch(first + half + half / 2);
+			first += advance(first[half - 1], key) ? half : 0;
+			count -= half;
+		}
+		return first + (advance(first[0], key) ? 1 : 0);
+	}
+
+	// Буфер сливается, когда перестаёт быть малым относительно основы:
+	// редкие O(n + k) слияния вместо O(n) на каждый ключ
+	void FlushIfFull() {
+		if (staging_.Size() >= MIN_BATCH && staging_.Size() * 8u >= base_.Size()) {
+			Flush();
+		}
+	}
+
+	static constexpr size_t MIN_BATCH = 64;
+
+	Vector<T> base_;
+	Vector<T> staging_;
+	Compare cmp_;
+};
@@ -0,0 +1,274 @@
+﻿#pragma once
+#include "vector.h"
+
+#include <bit>
+#include <cstdint>
+
+// Контейнер со стабильными адресами в духе hive/colony: элементы живут в чанках
+// фиксированного размера и никогда не перемещаются — ни при росте, ни при
+// удалении. Erase лишь помечает слот свободным (O(1)), следующий Emplace
+// переиспользует его; обход пропускает свободные слоты по битовой карте
+// занятости. Подходит для нагрузок, где на элементы держат долгоживущие
+// указатели: в отличие от Vector, ни одна операция их не инвалидирует
+template <typename T, size_t CHUNK_CAPACITY = 1024, typename Alloc = NewDeleteAllocator<T>>
+class StableVector {
+	static_assert((CHUNK_CAPACITY & (CHUNK_CAPACITY - 1)) == 0,
+		"CHUNK_CAPACITY must be a power of two");
+
+	template <bool IS_CONST>
+	class BasicIterator;
+
+public:
+	using iterator = BasicIterator<false>;
+	using const_iterator = BasicIterator<true>;
+
+	StableVector() = default;
+
+	StableVector(const StableVector& other)
+		: alloc_(other.alloc_) {
+		for (const T& value : other) {
+			Emplace(value);
+		}
+	}
+
+	StableVector& operator=(const StableVector& rhs) {
+		if (this != &rhs) {
+			StableVector rhs_copy(rhs);
+			Swap(rhs_copy);
+		}
+		return *this;
+	}
+
+	StableVector(StableVector&& other) noexcept
+		: chunks_(std::move(other.chunks_))
+		, occupied_(std::move(other.occupied_))
+		, free_slots_(std::move(other.free_slots_))
+		, alloc_(std::move(other.alloc_))
+		, size_(std::exchange(other.size_, 0))
+		, high_water_(std::exchange(other.high_water_, 0)) {
+	}
+
+	StableVector& operator=(StableVector&& rhs) noexcept {
+		Swap(rhs);
+		return *this;
+	}
+
+	~StableVector() {
+		for (size_t index = NextOccupied(0); index != high_water_; index = NextOccupied(index + 1)) {
+			std::destroy_at(&SlotAt(index));
+		}
+		for (size_t chunk = 0; chunk < chunks_.Size(); ++chunk) {
+			alloc_.Deallocate(chunks_[chunk], CHUNK_CAPACITY);
+		}
+	}
+
+	iterator begin() noexcept {
+		return iterator(this, NextOccupied(0));
+	}
+
+	iterator end() noexcept {
+		return iterator(this, high_water_);
+	}
+
+	const_iterator begin() const noexcept {
+		return const_iterator(this, NextOccupied(0));
+	}
+
+	const_iterator end() const noexcept {
+		return const_iterator(this, high_water_);
+	}
+
+	const_iterator cbegin() const noexcept {
+		return begin();
+	}
+
+	const_iterator cend() const noexcept {
+		return end();
+	}
+
+	size_t Size() const noexcept {
+		return size_;
+	}
+
+	size_t Capacity() const noexcept {
+		return chunks_.Size() * CHUNK_CAPACITY;
+	}
+
+	bool Empty() const noexcept {
+		return size_ == 0;
+	}
+
+	// Вставляет элемент в свободный слот (последний освобождённый — первым)
+	// или в конец; адрес результата стабилен до самого Erase этого элемента
+	template <typename... Args>
+	T& Emplace(Args&&... args) {
+		size_t index;
+		if (free_slots_.Size() != 0) {
+			index = free_slots_[free_slots_.Size() - 1];
+		}
+		else {
+			if (high_water_ == Capacity()) {
+				// Новый чанк и хвост битовой карты; старые чанки не трогаются
+				chunks_.PushBack(alloc_.Allocate(CHUNK_CAPACITY));
+				while (occupied_.Size() * 64u < Capacity()) {
+					occupied_.PushBack(uint64_t{0});
+				}
+			}
+			index = high_water_;
+		}
+		T* slot = &SlotAt(index);
+		new (slot) T(std::forward<Args>(args)...);
+		// Учёт слота только после успешного конструирования: при исключении
+		// контейнер остаётся в прежнем состоянии
+		if (free_slots_.Size() != 0) {
+			free_slots_.PopBack();
+		}
+		else {
+			++high_water_;
+		}
+		occupied_[index / 64u] |= uint64_t{1} << (index % 64u);
+		++size_;
+		return *slot;
+	}
+
+	T& PushBack(const T& value) {
+		return Emplace(value);
+	}
+
+	T& PushBack(T&& value) {
+		return Emplace(std::move(value));
+	}
+
+	// Разрушает элемент и отдаёт его слот в список переиспользования;
+	// остальные элементы не перемещаются. Возвращает итератор на следующий живой
+	iterator Erase(const_iterator pos) {
+		const size_t index = pos.index_;
+		assert(IsOccupied(index));
+		std::destroy_at(&SlotAt(index));
+		occupied_[index / 64u] &= ~(uint64_t{1} << (index % 64u));
+		free_slots_.PushBack(index);
+		--size_;
+		return iterator(this, NextOccupied(index + 1));
+	}
+
+	// Восстанавливает итератор по стабильному указателю на элемент; O(числа чанков)
+	iterator GetIterator(const T* ptr) noexcept {
+		for (size_t chunk = 0; chunk < chunks_.Size(); ++chunk) {
+			const T* chunk_begin = chunks_[chunk];
+			if (ptr >= chunk_begin && ptr < chunk_begin + CHUNK_CAPACITY) {
+				const size_t index = chunk * CHUNK_CAPACITY + static_cast<size_t>(ptr - chunk_begin);
+				assert(IsOccupied(index));
+				return iterator(this, index);
+			}
+		}
+		return end();
+	}
+
+	void Swap(StableVector& other) noexcept {
+		chunks_.Swap(other.chunks_);
+		occupied_.Swap(other.occupied_);
+		free_slots_.Swap(other.free_slots_);
+		std::swap(alloc_, other.alloc_);
+		std::swap(size_, other.size_);
+		std::swap(high_water_, other.high_water_);
+	}
+
+private:
+	// Однонаправленный итератор: хранит глобальный индекс слота и при продвижении
+	// перескакивает свободные слоты по словам битовой карты
+	template <bool IS_CONST>
+	class BasicIterator {
+		friend class StableVector;
+
+		template <bool OTHER_CONST>
+		friend class BasicIterator;
+
+		using Owner = std::conditional_t<IS_CONST, const StableVector, StableVector>;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<IS_CONST, const T*, T*>;
+		using reference = std::conditional_t<IS_CONST, const T&, T&>;
+
+		BasicIterator() = default;
+
+		template <bool C = IS_CONST, typename = std::enable_if_t<C>>
+		BasicIterator(const BasicIterator<false>& other) noexcept
+			: owner_(other.owner_)
+			, index_(other.index_) {
+		}
+
+		reference operator*() const noexcept {
+			return owner_->SlotAt(index_);
+		}
+
+		pointer operator->() const noexcept {
+			return &owner_->SlotAt(index_);
+		}
+
+		BasicIterator& operator++() noexcept {
+			index_ = owner_->NextOccupied(index_ + 1);
+			return *this;
+		}
+
+		BasicIterator operator++(int) noexcept {
+			BasicIterator copy(*this);
+			++(*this);
+			return copy;
+		}
+
+		template <bool OTHER_CONST>
+		bool operator==(const BasicIterator<OTHER_CONST>& rhs) const noexcept {
+			return index_ == rhs.index_;
+		}
+
+		template <bool OTHER_CONST>
+		bool operator!=(const BasicIterator<OTHER_CONST>& rhs) const noexcept {
+			return index_ != rhs.index_;
+		}
+
+	private:
+		BasicIterator(Owner* owner, size_t index) noexcept
+			: owner_(owner)
+			, index_(index) {
+		}
+
+		Owner* owner_ = nullptr;
+		size_t index_ = 0;
+	};
+
+	T& SlotAt(size_t index) noexcept {
+		return chunks_[index / CHUNK_CAPACITY][index % CHUNK_CAPACITY];
+	}
+
+	const T& SlotAt(size_t index) const noexcept {
+		return const_cast<StableVector&>(*this).SlotAt(index);
+	}
+
+	bool IsOccupied(size_t index) const noexcept {
+		return (occupied_[index / 64u] >> (index % 64u)) & 1u;
+	}
+
+	// Индекс первого занятого слота, начиная с from; high_water_, если таких нет
+	size_t NextOccupied(size_t from) const noexcept {
+		size_t word = from / 64u;
+		uint64_t mask = ~uint64_t{0} << (from % 64u);
+		for (; word < occupied_.Size(); ++word, mask = ~uint64_t{0}) {
+			const uint64_t bits = occupied_[word] & mask;
+			if (bits != 0) {
+				return word * 64u + static_cast<size_t>(std::countr_zero(bits));
+			}
+		}
+		return high_water_;
+	}
+
+	Vector<T*> chunks_;
+	Vector<uint64_t> occupied_;
+	Vector<size_t> free_slots_;
+	Alloc alloc_;
+	size_t size_ = 0;
+	// Граница когда-либо занимавшихся слотов; слоты выше неё ещё не выдавались
+	size_t high_water_ = 0;
+};
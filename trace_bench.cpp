@@ -0,0 +1,316 @@
+﻿// Трасс-ориентированный прогон движков хранения: операционная трасса
+// (захваченная с боевого кода регистратором или синтетическая) проигрывается
+// против нескольких движков, и по каждому печатаются ops/sec, перенесённые при
+// реаллокациях байты, число выделений и пиковый RSS процесса.
+// Запуск: vector_trace [файл_трассы]; без аргумента — синтетическая нагрузка
+#define VECTOR_TRACE
+#define VECTOR_STATS
+
+#include "allocators.h"
+#include "shared_vector.h"
+#include "segmented_vector.h"
+#include "vector.h"
+#include "vector_trace.h"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+    using Value = int64_t;
+
+    // Пиковый RSS процесса в килобайтах; 0, если платформа не умеет
+    long PeakRssKb() {
+#if defined(__linux__)
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;
+#else
+        return 0;
+#endif
+    }
+
+    struct ReplayResult {
+        double millis = 0.0;
+        uint64_t ops = 0;
+        size_t allocations = 0;
+        size_t bytes_copied = 0;
+        long peak_rss_kb = 0;
+    };
+
+    // Движок на Vector: полный набор операций, статистика — из VECTOR_STATS
+    template <typename Alloc = NewDeleteAllocator<Value>>
+    struct VectorEngine {
+        Vector<Value, Alloc> v;
+        uint64_t sink = 0;
+
+        void ResetStats() {
+            Vector<Value, Alloc>::GetStats().Reset();
+        }
+
+        size_t Allocations() const {
+            return Vector<Value, Alloc>::GetStats().allocations;
+        }
+
+        size_t BytesCopied() const {
+            return Vector<Value, Alloc>::GetStats().bytes_copied;
+        }
+
+        void Append(uint64_t count) {
+            for (uint64_t i = 0; i < count; ++i) {
+                v.PushBack(static_cast<Value>(i));
+            }
+        }
+
+        void Insert(uint64_t index) {
+            v.Insert(v.cbegin() + index % (v.Size() + 1u), static_cast<Value>(index));
+        }
+
+        void Erase(uint64_t index) {
+            if (v.Size() != 0) {
+                v.Erase(v.cbegin() + index % v.Size());
+            }
+        }
+
+        void Scan() {
+            Value sum = 0;
+            for (size_t i = 0; i < v.Size(); ++i) {
+                sum += v[i];
+            }
+            sink += static_cast<uint64_t>(sum);
+        }
+
+        void Snapshot() {
+            Vector<Value, Alloc> copy(v);
+            sink += copy.Size();
+        }
+    };
+
+    // Сегментированный движок: стабильные адреса, рост без блочного переноса.
+    // Вставок и удалений в середине у него нет — они замыкаются на конец,
+    // поэтому его колонки сравнимы только по append/scan-нагрузкам
+    struct SegmentedEngine {
+        SegmentedVector<Value> v;
+        uint64_t sink = 0;
+
+        void ResetStats() {
+        }
+
+        size_t Allocations() const {
+            return 0;
+        }
+
+        size_t BytesCopied() const {
+            return 0;
+        }
+
+        void Append(uint64_t count) {
+            for (uint64_t i = 0; i < count; ++i) {
+                v.PushBack(static_cast<Value>(i));
+            }
+        }
+
+        void Insert(uint64_t index) {
+            v.PushBack(static_cast<Value>(index));
+        }
+
+        void Erase(uint64_t /*index*/) {
+            if (v.Size() != 0) {
+                v.PopBack();
+            }
+        }
+
+        void Scan() {
+            Value sum = 0;
+            for (size_t i = 0; i < v.Size(); ++i) {
+                sum += v[i];
+            }
+            sink += static_cast<uint64_t>(sum);
+        }
+
+        void Snapshot() {
+            SegmentedVector<Value> copy(v);
+            sink += copy.Size();
+        }
+    };
+
+    // COW-движок: снимки O(1), правки после снимка платят одним копированием
+    struct CowEngine {
+        SharedVector<Value> v;
+        SharedVector<Value> last_snapshot;
+        uint64_t sink = 0;
+
+        void ResetStats() {
+            Vector<Value>::GetStats().Reset();
+        }
+
+        size_t Allocations() const {
+            return Vector<Value>::GetStats().allocations;
+        }
+
+        size_t BytesCopied() const {
+            return Vector<Value>::GetStats().bytes_copied;
+        }
+
+        void Append(uint64_t count) {
+            for (uint64_t i = 0; i < count; ++i) {
+                v.PushBack(static_cast<Value>(i));
+            }
+        }
+
+        void Insert(uint64_t index) {
+            v.PushBack(static_cast<Value>(index));
+        }
+
+        void Erase(uint64_t /*index*/) {
+            if (v.Size() != 0) {
+                v.PopBack();
+            }
+        }
+
+        void Scan() {
+            Value sum = 0;
+            for (const Value& value : v) {
+                sum += value;
+            }
+            sink += static_cast<uint64_t>(sum);
+        }
+
+        void Snapshot() {
+            last_snapshot = v.Snapshot();
+            sink += last_snapshot.UseCount();
+        }
+    };
+
+    // Проигрывает трассу против движка; ops — число элементарных операций
+    template <typename Engine>
+    ReplayResult Replay(const Trace& trace) {
+        Engine engine;
+        engine.ResetStats();
+        ReplayResult result;
+        const auto start = std::chrono::steady_clock::now();
+        for (const TraceEvent& event : trace) {
+            switch (static_cast<TraceOp>(event.op)) {
+            case TraceOp::APPEND:
+                engine.Append(event.arg);
+                result.ops += event.arg;
+                break;
+            case TraceOp::INSERT:
+                engine.Insert(event.arg);
+                ++result.ops;
+                break;
+            case TraceOp::ERASE:
+                engine.Erase(event.arg);
+                ++result.ops;
+                break;
+            case TraceOp::SCAN:
+                engine.Scan();
+                result.ops += engine.v.Size();
+                break;
+            case TraceOp::SNAPSHOT:
+                engine.Snapshot();
+                ++result.ops;
+                break;
+            }
+        }
+        const auto stop = std::chrono::steady_clock::now();
+        result.millis = std::chrono::duration<double, std::milli>(stop - start).count();
+        result.allocations = engine.Allocations();
+        result.bytes_copied = engine.BytesCopied();
+        result.peak_rss_kb = PeakRssKb();
+        return result;
+    }
+
+    void Report(std::string_view name, const ReplayResult& result) {
+        const double mops = static_cast<double>(result.ops) / 1e6 / (result.millis / 1e3);
+        std::cout << std::left << std::setw(28) << name << std::right << std::fixed
+            << std::setprecision(3) << std::setw(12) << result.millis << " ms"
+            << std::setprecision(1) << std::setw(10) << mops << " Mops/s"
+            << std::setw(12) << result.bytes_copied / 1024 << " KiB moved"
+            << std::setw(8) << result.allocations << " allocs"
+            << std::setw(10) << result.peak_rss_kb << " KB RSS" << std::endl;
+    }
+
+    // Синтетическая трасса в духе индексной нагрузки: пачки добавлений,
+    // точечные вставки/удаления, периодические сканы и снимки
+    Trace BuildSyntheticTrace() {
+        Trace trace;
+        uint64_t state = 1;
+        for (int phase = 0; phase < 50; ++phase) {
+            trace.Note(TraceOp::APPEND, 20'000);
+            for (int i = 0; i < 200; ++i) {
+                state = state * 6364136223846793005ull + 1442695040888963407ull;
+                trace.Note(TraceOp::INSERT, state >> 33u);
+                state = state * 6364136223846793005ull + 1442695040888963407ull;
+                trace.Note(TraceOp::ERASE, state >> 33u);
+            }
+            trace.Note(TraceOp::SCAN);
+            if (phase % 10 == 9) {
+                trace.Note(TraceOp::SNAPSHOT);
+            }
+        }
+        return trace;
+    }
+
+    // Демонстрация регистратора: трасса снимается с обычного кода на Vector,
+    // переживает сериализацию и пригодна для прогона
+    Trace RecordSampleTrace() {
+        Trace recorded;
+        {
+            TraceRecorder recorder(recorded);
+            Vector<Value> v;
+            for (int i = 0; i < 10'000; ++i) {
+                v.PushBack(i);
+            }
+            for (int i = 0; i < 100; ++i) {
+                v.Insert(v.cbegin() + (i * 37) % v.Size(), i);
+                v.Erase(v.cbegin() + (i * 53) % v.Size());
+            }
+        }
+        std::stringstream buffer;
+        recorded.Save(buffer);
+        Trace loaded;
+        loaded.Load(buffer);
+        assert(loaded.Size() == recorded.Size());
+        return loaded;
+    }
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Trace trace;
+    if (argc > 1) {
+        std::ifstream in(argv[1], std::ios::binary);
+        if (!in) {
+            std::cerr << "cannot open trace file: " << argv[1] << std::endl;
+            return 1;
+        }
+        trace.Load(in);
+        std::cout << "trace: " << argv[1] << ", " << trace.Size() << " events" << std::endl;
+    }
+    else {
+        trace = BuildSyntheticTrace();
+        std::cout << "trace: synthetic, " << trace.Size() << " events" << std::endl;
+    }
+
+    Report("Vector", Replay<VectorEngine<>>(trace));
+    Report("Vector+PoolAllocator", Replay<VectorEngine<PoolAllocator<Value>>>(trace));
+    Report("SegmentedVector", Replay<SegmentedEngine>(trace));
+    Report("SharedVector (COW)", Replay<CowEngine>(trace));
+
+    std::cout << std::endl;
+    const Trace recorded = RecordSampleTrace();
+    std::cout << "recorded trace: " << recorded.Size() << " events (serialization roundtrip ok)"
+        << std::endl;
+    Report("Vector (recorded)", Replay<VectorEngine<>>(recorded));
+    return 0;
+}
@@ -2,18 +2,385 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <memory>
 #include <new>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 
+// Основные операции (конструкторы, Reserve, PushBack/EmplaceBack, Resize, доступ
+// по индексу) помечены constexpr: Vector можно наполнять в константных вычислениях
+// и материализовать готовые таблицы в .rodata. В constant evaluation память идёт
+// через std::allocator, а блочные memcpy-пути заменяются поэлементными циклами
+//
+// Заголовок можно использовать в сборках с -fno-exceptions (или с VECTOR_NO_EXCEPTIONS):
+// try/catch путей отката компилируется только при включённых исключениях. Для типов
+// с nothrow-перемещением EH-каркас не генерируется вовсе — ветки выбраны через if constexpr
+#if defined(VECTOR_NO_EXCEPTIONS) || (!defined(__cpp_exceptions) && !defined(_CPPUNWIND))
+#define VECTOR_HAS_EXCEPTIONS 0
+#else
+#define VECTOR_HAS_EXCEPTIONS 1
+#endif
+
+// Отладочный режим VECTOR_CHECKED: жёсткая (не зависящая от NDEBUG) проверка
+// границ в operator[], итераторы со счётчиком поколений, ловящие обращение
+// после инвалидации реаллокацией, и затирание освобождаемой памяти байтом 0xDD.
+// Без макроса весь этот код не компилируется — релиз остаётся прежним
+#if defined(VECTOR_CHECKED)
+#include <cstdio>
+
+#define VECTOR_NOEXCEPT_UNCHECKED
+
+// Обработчик нарушений; тесты могут подставить свой (в том числе бросающий
+// исключение), по умолчанию — сообщение в stderr и abort
+inline void (*vector_checked_violation_handler)(const char* what) = nullptr;
+
+inline void VectorCheckedViolation(const char* what) {
+	if (vector_checked_violation_handler != nullptr) {
+		vector_checked_violation_handler(what);
+	}
+	std::fprintf(stderr, "Vector checked mode: %s\n", what);
+	std::abort();
+}
+
+// Итератор отладочного режима: помнит поколение буфера на момент создания
+// и при каждом разыменовании сверяет его с текущим поколением владельца
+template <typename Vec, typename ValueT, bool IS_CONST>
+class VectorCheckedIterator {
+	friend Vec;
+
+	template <typename, typename, bool>
+	friend class VectorCheckedIterator;
+
+public:
+	using iterator_category = std::random_access_iterator_tag;
+	using value_type = ValueT;
+	using difference_type = std::ptrdiff_t;
+	using pointer = std::conditional_t<IS_CONST, const ValueT*, ValueT*>;
+	using reference = std::conditional_t<IS_CONST, const ValueT&, ValueT&>;
+
+	constexpr VectorCheckedIterator() = default;
+
+	// Неконстантный итератор неявно приводится к константному; ограничение
+	// не даёт этому конструктору стать пользовательским копирующим
+	template <bool C = IS_CONST, typename = std::enable_if_t<C>>
+	constexpr VectorCheckedIterator(const VectorCheckedIterator<Vec, ValueT, false>& other) noexcept
+		: ptr_(other.ptr_)
+		, owner_(other.owner_)
+		, generation_(other.generation_) {
+	}
+
+	constexpr reference operator*() const {
+		Validate();
+		return *ptr_;
+	}
+
+	constexpr pointer operator->() const {
+		Validate();
+		return ptr_;
+	}
+
+	constexpr reference operator[](difference_type offset) const {
+		Validate();
+		return ptr_[offset];
+	}
+
+	constexpr VectorCheckedIterator& operator++() noexcept {
+		++ptr_;
+		return *this;
+	}
+
+	constexpr VectorCheckedIterator operator++(int) noexcept {
+		VectorCheckedIterator copy(*this);
+		++ptr_;
+		return copy;
+	}
+
+	constexpr VectorCheckedIterator& operator--() noexcept {
+		--ptr_;
+		return *this;
+	}
+
+	constexpr VectorCheckedIterator operator--(int) noexcept {
+		VectorCheckedIterator copy(*this);
+		--ptr_;
+		return copy;
+	}
+
+	constexpr VectorCheckedIterator& operator+=(difference_type offset) noexcept {
+		ptr_ += offset;
+		return *this;
+	}
+
+	constexpr VectorCheckedIterator& operator-=(difference_type offset) noexcept {
+		ptr_ -= offset;
+		return *this;
+	}
+
+	friend constexpr VectorCheckedIterator operator+(VectorCheckedIterator it, difference_type offset) noexcept {
+		return it += offset;
+	}
+
+	friend constexpr VectorCheckedIterator operator+(difference_type offset, VectorCheckedIterator it) noexcept {
+		return it += offset;
+	}
+
+	friend constexpr VectorCheckedIterator operator-(VectorCheckedIterator it, difference_type offset) noexcept {
+		return it -= offset;
+	}
+
+	template <bool OTHER_CONST>
+	constexpr difference_type operator-(const VectorCheckedIterator<Vec, ValueT, OTHER_CONST>& rhs) const noexcept {
+		return ptr_ - rhs.ptr_;
+	}
+
+	template <bool OTHER_CONST>
+	constexpr bool operator==(const VectorCheckedIterator<Vec, ValueT, OTHER_CONST>& rhs) const noexcept {
+		return ptr_ == rhs.ptr_;
+	}
+
+	template <bool OTHER_CONST>
+	constexpr bool operator!=(const VectorCheckedIterator<Vec, ValueT, OTHER_CONST>& rhs) const noexcept {
+		return ptr_ != rhs.ptr_;
+	}
+
+	template <bool OTHER_CONST>
+	constexpr bool operator<(const VectorCheckedIterator<Vec, ValueT, OTHER_CONST>& rhs) const noexcept {
+		return ptr_ < rhs.ptr_;
+	}
+
+	template <bool OTHER_CONST>
+	constexpr bool operator<=(const VectorCheckedIterator<Vec, ValueT, OTHER_CONST>& rhs) const noexcept {
+		return ptr_ <= rhs.ptr_;
+	}
+
+	template <bool OTHER_CONST>
+	constexpr bool operator>(const VectorCheckedIterator<Vec, ValueT, OTHER_CONST>& rhs) const noexcept {
+		return ptr_ > rhs.ptr_;
+	}
+
+	template <bool OTHER_CONST>
+	constexpr bool operator>=(const VectorCheckedIterator<Vec, ValueT, OTHER_CONST>& rhs) const noexcept {
+		return ptr_ >= rhs.ptr_;
+	}
+
+private:
+	constexpr VectorCheckedIterator(pointer ptr, const Vec* owner) noexcept
+		: ptr_(ptr)
+		, owner_(owner)
+		, generation_(owner->generation_) {
+	}
+
+	constexpr void Validate() const {
+		if (owner_ != nullptr && owner_->generation_ != generation_) {
+			VectorCheckedViolation("iterator invalidated by reallocation");
+		}
+	}
+
+	pointer ptr_ = nullptr;
+	const Vec* owner_ = nullptr;
+	size_t generation_ = 0;
+};
+#else
+#define VECTOR_NOEXCEPT_UNCHECKED noexcept
+#endif
+
+// Крючок записи трасс (инструментированные сборки): при включённом VECTOR_TRACE
+// Vector сообщает регистратору о структурных операциях. Коды операций разделены
+// с vector_trace.h; без макроса вызовы компилируются в ничто
+#define VECTOR_TRACE_OP_APPEND 0u
+#define VECTOR_TRACE_OP_INSERT 1u
+#define VECTOR_TRACE_OP_ERASE 2u
+
+#if defined(VECTOR_TRACE)
+inline void (*vector_trace_hook)(uint8_t op, size_t arg) = nullptr;
+
+constexpr void VectorTraceNote(uint8_t op, size_t arg) {
+	if (std::is_constant_evaluated()) {
+		return;
+	}
+	if (vector_trace_hook != nullptr) {
+		vector_trace_hook(op, arg);
+	}
+}
+#else
+#define VectorTraceNote(op, arg) ((void)0)
+#endif
+
+// Опциональный параллельный режим массовых операций (конструирование, копирование,
+// разрушение): включается макросом VECTOR_PARALLEL_BULK и срабатывает только на
+// nothrow-операциях и размерах от VECTOR_PARALLEL_THRESHOLD элементов
+#if defined(VECTOR_PARALLEL_BULK)
+#include <thread>
+#include <vector>
+
+#ifndef VECTOR_PARALLEL_THRESHOLD
+#define VECTOR_PARALLEL_THRESHOLD (size_t{1} << 20u)
+#endif
+
+// Делит [0, count) на равные куски по числу аппаратных потоков; fn(begin, n)
+template <typename Fn>
+void ParallelForChunks(size_t count, Fn fn) {
+	const size_t hw = std::thread::hardware_concurrency();
+	const size_t num_threads = hw == 0 ? 1 : hw;
+	if (num_threads == 1) {
+		fn(0, count);
+		return;
+	}
+	const size_t chunk = (count + num_threads - 1) / num_threads;
+	std::vector<std::thread> workers;
+	workers.reserve(num_threads - 1);
+	size_t begin = chunk;
+	for (size_t t = 1; t < num_threads && begin < count; ++t, begin += chunk) {
+		const size_t n = begin + chunk > count ? count - begin : chunk;
+		workers.emplace_back(fn, begin, n);
+	}
+	fn(0, chunk < count ? chunk : count);
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+}
+#endif
+
+template <typename T>
+constexpr void BulkValueConstruct(T* ptr, size_t count) {
+	if (std::is_constant_evaluated()) {
+		for (size_t i = 0; i < count; ++i) {
+			std::construct_at(ptr + i);
+		}
+		return;
+	}
+#if defined(VECTOR_PARALLEL_BULK)
+	if constexpr (std::is_nothrow_default_constructible_v<T>) {
+		if (count >= VECTOR_PARALLEL_THRESHOLD) {
+			ParallelForChunks(count, [ptr](size_t begin, size_t n) {
+				std::uninitialized_value_construct_n(ptr + begin, n);
+				});
+			return;
+		}
+	}
+#endif
+	std::uninitialized_value_construct_n(ptr, count);
+}
+
 template <typename T>
+constexpr void BulkDefaultConstruct(T* ptr, size_t count) {
+	// В константных вычислениях неинициализированных элементов не бывает
+	if (std::is_constant_evaluated()) {
+		for (size_t i = 0; i < count; ++i) {
+			std::construct_at(ptr + i);
+		}
+		return;
+	}
+#if defined(VECTOR_PARALLEL_BULK)
+	if constexpr (std::is_nothrow_default_constructible_v<T>) {
+		if (count >= VECTOR_PARALLEL_THRESHOLD) {
+			ParallelForChunks(count, [ptr](size_t begin, size_t n) {
+				std::uninitialized_default_construct_n(ptr + begin, n);
+				});
+			return;
+		}
+	}
+#endif
+	std::uninitialized_default_construct_n(ptr, count);
+}
+
+template <typename T>
+constexpr void BulkCopyConstruct(const T* src, size_t count, T* dst) {
+	if (std::is_constant_evaluated()) {
+		for (size_t i = 0; i < count; ++i) {
+			std::construct_at(dst + i, src[i]);
+		}
+		return;
+	}
+#if defined(VECTOR_PARALLEL_BULK)
+	if constexpr (std::is_nothrow_copy_constructible_v<T>) {
+		if (count >= VECTOR_PARALLEL_THRESHOLD) {
+			ParallelForChunks(count, [src, dst](size_t begin, size_t n) {
+				std::uninitialized_copy_n(src + begin, n, dst + begin);
+				});
+			return;
+		}
+	}
+#endif
+	std::uninitialized_copy_n(src, count, dst);
+}
+
+template <typename T>
+constexpr void BulkDestroy(T* ptr, size_t count) noexcept {
+	if (std::is_constant_evaluated()) {
+		std::destroy_n(ptr, count);
+		return;
+	}
+#if defined(VECTOR_PARALLEL_BULK)
+	if constexpr (!std::is_trivially_destructible_v<T>) {
+		if (count >= VECTOR_PARALLEL_THRESHOLD) {
+			ParallelForChunks(count, [ptr](size_t begin, size_t n) {
+				std::destroy_n(ptr + begin, n);
+				});
+			return;
+		}
+	}
+#endif
+	std::destroy_n(ptr, count);
+}
+
+// Аллокатор по умолчанию: сырая память запрашивается у глобальных operator new/delete
+template <typename T>
+struct NewDeleteAllocator {
+	constexpr T* Allocate(size_t n) {
+		if (std::is_constant_evaluated()) {
+			// В константных вычислениях память выдаёт std::allocator — как в constexpr std::vector
+			return std::allocator<T>{}.allocate(n);
+		}
+		return static_cast<T*>(operator new(n * sizeof(T)));
+	}
+
+	constexpr void Deallocate(T* buf, size_t n) noexcept {
+		if (std::is_constant_evaluated()) {
+			std::allocator<T>{}.deallocate(buf, n);
+			return;
+		}
+		operator delete(buf);
+	}
+};
+
+// Определяет, умеет ли аллокатор расширять блок на месте через Reallocate
+template <typename Alloc, typename T, typename = void>
+struct HasReallocate : std::false_type {};
+
+template <typename Alloc, typename T>
+struct HasReallocate<Alloc, T,
+	std::void_t<decltype(std::declval<Alloc&>().Reallocate(std::declval<T*>(), size_t{}, size_t{}))>>
+	: std::true_type {
+};
+
+// Признак тривиальной перемещаемости: объект можно перенести по новому адресу
+// одним побайтовым копированием, не вызывая ни move-конструктор, ни деструктор
+// исходника. По умолчанию выводится из тривиальной копируемости; для собственных
+// типов без самоссылок (например, обёрток над указателями) трейт можно
+// специализировать и получить блочный перенос при реаллокации
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+inline constexpr bool IsTriviallyRelocatableV = IsTriviallyRelocatable<T>::value;
+
+template <typename T, typename Alloc = NewDeleteAllocator<T>>
 class RawMemory {
 public:
 	RawMemory() = default;
 
-	explicit RawMemory(size_t capacity)
-		: buffer_(Allocate(capacity))
+	constexpr explicit RawMemory(Alloc alloc) noexcept
+		: alloc_(std::move(alloc)) {
+	}
+
+	constexpr explicit RawMemory(size_t capacity, Alloc alloc = Alloc{})
+		: alloc_(std::move(alloc))
+		, buffer_(Allocate(alloc_, capacity))
 		, capacity_(capacity) {
 	}
 
@@ -21,200 +388,380 @@ public:
 
 	RawMemory& operator=(const RawMemory& rhs) = delete;
 
-	RawMemory(RawMemory&& other) noexcept {
+	constexpr RawMemory(RawMemory&& other) noexcept {
 		Swap(other);
 	}
 
-	RawMemory& operator=(RawMemory&& rhs) noexcept {
+	constexpr RawMemory& operator=(RawMemory&& rhs) noexcept {
 		Swap(rhs);
 		return *this;
 	}
 
-	~RawMemory() {
-		Deallocate(buffer_);
+	constexpr ~RawMemory() {
+		Deallocate();
 	}
 
-	T* operator+(size_t offset) noexcept {
+	constexpr T* operator+(size_t offset) noexcept {
 		// Разрешается получать адрес ячейки памяти, следующей за последним элементом массива
 		assert(offset <= capacity_);
 		return buffer_ + offset;
 	}
 
-	const T* operator+(size_t offset) const noexcept {
+	constexpr const T* operator+(size_t offset) const noexcept {
 		return const_cast<RawMemory&>(*this) + offset;
 	}
 
-	const T& operator[](size_t index) const noexcept {
+	constexpr const T& operator[](size_t index) const noexcept {
 		return const_cast<RawMemory&>(*this)[index];
 	}
 
-	T& operator[](size_t index) noexcept {
+	constexpr T& operator[](size_t index) noexcept {
 		assert(index < capacity_);
 		return buffer_[index];
 	}
 
-	void Swap(RawMemory& other) noexcept {
+	constexpr void Swap(RawMemory& other) noexcept {
+		std::swap(alloc_, other.alloc_);
 		std::swap(buffer_, other.buffer_);
 		std::swap(capacity_, other.capacity_);
 	}
 
-	const T* GetAddress() const noexcept {
+	constexpr const Alloc& GetAllocator() const noexcept {
+		return alloc_;
+	}
+
+	// Пытается расширить буфер на месте; доступно только аллокаторам с Reallocate
+	// и корректно лишь для тривиально перемещаемых побайтово элементов
+	bool TryReallocate(size_t new_capacity) {
+		if constexpr (HasReallocate<Alloc, T>::value) {
+			T* new_buf = alloc_.Reallocate(buffer_, capacity_, new_capacity);
+			if (new_buf == nullptr) {
+				return false;
+			}
+			buffer_ = new_buf;
+			capacity_ = new_capacity;
+			return true;
+		}
+		else {
+			return false;
+		}
+	}
+
+	constexpr const T* GetAddress() const noexcept {
 		return buffer_;
 	}
 
-	T* GetAddress() noexcept {
+	constexpr T* GetAddress() noexcept {
 		return buffer_;
 	}
 
-	size_t Capacity() const {
+	constexpr size_t Capacity() const {
 		return capacity_;
 	}
 
 private:
 	// Выделяет сырую память под n элементов и возвращает указатель на неё
-	static T* Allocate(size_t n) {
-		return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+	static constexpr T* Allocate(Alloc& alloc, size_t n) {
+		return n != 0 ? alloc.Allocate(n) : nullptr;
 	}
 
-	// Освобождает сырую память, выделенную ранее по адресу buf при помощи Allocate
-	static void Deallocate(T* buf) noexcept {
-		operator delete(buf);
+	// Освобождает сырую память, выделенную ранее при помощи Allocate
+	constexpr void Deallocate() noexcept {
+		if (buffer_ != nullptr) {
+#if defined(VECTOR_CHECKED)
+			// Висячие указатели на освобождённый буфер читают узнаваемый мусор
+			if (!std::is_constant_evaluated()) {
+				std::memset(static_cast<void*>(buffer_), 0xDD, capacity_ * sizeof(T));
+			}
+#endif
+			alloc_.Deallocate(buffer_, capacity_);
+		}
 	}
 
+	Alloc alloc_{};
 	T* buffer_ = nullptr;
 	size_t capacity_ = 0;
 };
 
 
-template <typename T>
+// Накопительная статистика по всем векторам одного типа элементов. Заполняется
+// только в сборках с VECTOR_STATS; без него учётные вызовы — пустые inline-функции
+struct VectorStats {
+	using ReallocationCallback = void (*)(size_t old_capacity, size_t new_capacity);
+
+	size_t allocations = 0;        // выделений буферов
+	size_t reallocations = 0;      // переездов/расширений существующего буфера
+	size_t peak_capacity = 0;      // максимальная ёмкость в элементах
+	size_t bytes_copied = 0;       // байт, перенесённых при реаллокациях
+	ReallocationCallback on_reallocation = nullptr;
+
+	void Reset() noexcept {
+		*this = VectorStats{};
+	}
+};
+
+// Политика роста по умолчанию: удвоение ёмкости
+struct GrowthX2 {
+	static constexpr size_t Grow(size_t capacity, size_t /*elem_size*/) noexcept {
+		return capacity == 0 ? 1 : capacity * 2;
+	}
+};
+
+// Рост в полтора раза: меньше мёртвой ёмкости у долгоживущих векторов
+struct GrowthX1_5 {
+	static constexpr size_t Grow(size_t capacity, size_t /*elem_size*/) noexcept {
+		return capacity < 2 ? capacity + 1 : capacity + capacity / 2;
+	}
+};
+
+// Рост с округлением размера буфера вверх до целых страниц
+struct GrowthPageQuantized {
+	static const size_t PAGE_SIZE = 4096;
+
+	static constexpr size_t Grow(size_t capacity, size_t elem_size) noexcept {
+		const size_t bytes = (capacity == 0 ? 1 : capacity * 2) * elem_size;
+		const size_t pages = (bytes + PAGE_SIZE - 1) / PAGE_SIZE;
+		return pages * PAGE_SIZE / elem_size;
+	}
+};
+
+template <typename T, typename Alloc = NewDeleteAllocator<T>, typename Growth = GrowthX2>
 class Vector {
 public:
+#if defined(VECTOR_CHECKED)
+	using iterator = VectorCheckedIterator<Vector, T, false>;
+	using const_iterator = VectorCheckedIterator<Vector, T, true>;
+
+	template <typename, typename, bool>
+	friend class VectorCheckedIterator;
+#else
 	using iterator = T*;
 	using const_iterator = const T*;
+#endif
+
+	constexpr Vector() = default;
 
-	Vector() = default;
+	constexpr explicit Vector(Alloc alloc) noexcept
+		: data_(std::move(alloc)) {
+	}
 
-	explicit Vector(size_t size)
-		: data_(size)
+	constexpr explicit Vector(size_t size, Alloc alloc = Alloc{})
+		: data_(size, std::move(alloc))
 		, size_(size) {
-		std::uninitialized_value_construct_n(data_.GetAddress(), size);
+		NoteAllocation(size);
+		BulkValueConstruct(data_.GetAddress(), size);
 	}
 
-	Vector(const Vector& other)
-		: data_(other.size_)
+	constexpr Vector(const Vector& other)
+		: data_(other.size_, other.data_.GetAllocator())
 		, size_(other.size_) {
-		std::uninitialized_copy_n(other.data_.GetAddress(), other.size_, data_.GetAddress());
+		NoteAllocation(other.size_);
+		BulkCopyConstruct(other.data_.GetAddress(), other.size_, data_.GetAddress());
 	}
 
-	Vector(Vector&& other) noexcept
+	constexpr Vector(Vector&& other) noexcept
 		: data_(std::move(other.data_))
-		, size_(std::exchange(other.size_, 0)) {
+		, size_(std::exchange(other.size_, 0))
+		, capacity_locked_(std::exchange(other.capacity_locked_, false)) {
 	}
 
-	~Vector() {
-		std::destroy_n(data_.GetAddress(), size_);
+	constexpr ~Vector() {
+		BulkDestroy(data_.GetAddress(), size_);
 	}
 
-	Vector& operator=(const Vector& rhs) {
+	constexpr Vector& operator=(const Vector& rhs) {
 		if (this != &rhs) {
 			if (rhs.size_ > data_.Capacity()) {
+				AssertCapacityUnlocked();
 				Vector rhs_copy(rhs);
 				Swap(rhs_copy);
 			}
-			else {
-				const size_t copy_count = rhs.Size() < size_ ? rhs.Size() : size_;
-				std::copy(rhs.data_.GetAddress(), rhs.data_ + copy_count, data_.GetAddress());
-				if (rhs.Size() < size_) {
-					std::destroy_n(data_ + rhs.Size(), size_ - rhs.Size());
+			else if constexpr (std::is_trivially_copyable_v<T>) {
+				if (std::is_constant_evaluated()) {
+					AssignPreservingElements(rhs);
 				}
-				else if (rhs.Size() > size_) {
-					std::uninitialized_copy_n(rhs.data_ + size_, rhs.Size() - size_, data_.GetAddress() + size_);
+				else {
+					if (rhs.size_ != 0) {
+						std::memcpy(static_cast<void*>(data_.GetAddress()), rhs.data_.GetAddress(), rhs.size_ * sizeof(T));
+					}
+					size_ = rhs.size_;
 				}
-				size_ = rhs.Size();
+			}
+			else {
+				AssignPreservingElements(rhs);
 			}
 		}
 		return *this;
 	}
 
-	Vector& operator=(Vector&& rhs) noexcept {
+	constexpr Vector& operator=(Vector&& rhs) noexcept {
 		Swap(rhs);
 		return *this;
 	}
 
-	iterator begin() noexcept {
-		return data_.GetAddress();
+	constexpr iterator begin() noexcept {
+		return Wrap(data_.GetAddress());
 	}
 
-	iterator end() noexcept {
-		return data_ + size_;
+	constexpr iterator end() noexcept {
+		return Wrap(data_ + size_);
 	}
 
-	const_iterator begin() const noexcept {
-		return data_.GetAddress();
+	constexpr const_iterator begin() const noexcept {
+		return Wrap(data_.GetAddress());
+	}
+
+	constexpr const_iterator end() const noexcept {
+		return Wrap(data_ + size_);
 	}
 
-	const_iterator end() const noexcept {
-		return data_ + size_;
+	constexpr const_iterator cbegin() const noexcept {
+		return Wrap(data_.GetAddress());
 	}
 
-	const_iterator cbegin() const noexcept {
+	constexpr const_iterator cend() const noexcept {
+		return Wrap(data_ + size_);
+	}
+
+	// Сырой указатель на непрерывный буфер — для bulk-операций и кода,
+	// которому нужен именно T* (в режиме VECTOR_CHECKED итераторы — не указатели)
+	constexpr T* Data() noexcept {
 		return data_.GetAddress();
 	}
 
-	const_iterator cend() const noexcept {
-		return data_ + size_;
+	constexpr const T* Data() const noexcept {
+		return data_.GetAddress();
 	}
 
-	size_t Size() const noexcept {
+	constexpr size_t Size() const noexcept {
 		return size_;
 	}
 
-	size_t Capacity() const noexcept {
+	constexpr size_t Capacity() const noexcept {
 		return data_.Capacity();
 	}
 
-	void Reserve(size_t new_capacity) {
+	// Байты ёмкости, не занятые живыми элементами
+	size_t WastedBytes() const noexcept {
+		return (data_.Capacity() - size_) * sizeof(T);
+	}
+
+	constexpr const Alloc& GetAllocator() const noexcept {
+		return data_.GetAllocator();
+	}
+
+	// Общая статистика всех векторов с данным набором параметров шаблона
+	static VectorStats& GetStats() noexcept {
+		static VectorStats stats;
+		return stats;
+	}
+
+	// Запрещает дальнейшие реаллокации: любая операция, требующая нового буфера,
+	// становится немедленной ошибкой (std::length_error либо assert+abort без
+	// исключений). Для real-time секций: после прогрева Reserve + LockCapacity
+	// доказуемо исключают аллокации и O(n) переносы на горячем пути
+	constexpr void LockCapacity() noexcept {
+		capacity_locked_ = true;
+	}
+
+	constexpr void UnlockCapacity() noexcept {
+		capacity_locked_ = false;
+	}
+
+	constexpr bool IsCapacityLocked() const noexcept {
+		return capacity_locked_;
+	}
+
+	constexpr void Reserve(size_t new_capacity) {
 		if (new_capacity <= data_.Capacity()) {
 			return;
 		}
-		RawMemory<T> new_data(new_capacity);
+		AssertCapacityUnlocked();
+		const size_t old_capacity = data_.Capacity();
+		if constexpr (IsTriviallyRelocatableV<T>) {
+			if (!std::is_constant_evaluated() && data_.TryReallocate(new_capacity)) {
+				BumpGeneration();
+				NoteReallocation(old_capacity, new_capacity, 0);
+				return;
+			}
+		}
+		RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+		NoteAllocation(new_capacity);
 		CopyOrMoveAndSwap(new_data);
+		NoteReallocation(old_capacity, new_capacity, size_ * sizeof(T));
 	}
 
-	const T& operator[](size_t index) const noexcept {
+	constexpr const T& operator[](size_t index) const VECTOR_NOEXCEPT_UNCHECKED {
 		return const_cast<Vector&>(*this)[index];
 	}
 
-	T& operator[](size_t index) noexcept {
+	constexpr T& operator[](size_t index) VECTOR_NOEXCEPT_UNCHECKED {
+#if defined(VECTOR_CHECKED)
+		if (index >= size_) {
+			VectorCheckedViolation("index out of range");
+		}
+#else
 		assert(index < size_);
+#endif
 		return data_[index];
 	}
 
-	void Swap(Vector& other) noexcept {
+	constexpr void Swap(Vector& other) noexcept {
 		data_.Swap(other.data_);
 		std::swap(size_, other.size_);
+		std::swap(capacity_locked_, other.capacity_locked_);
+		BumpGeneration();
+		other.BumpGeneration();
+	}
+
+	// Переаллоцирует буфер точно под текущий размер, возвращая лишнюю память
+	void ShrinkToFit() {
+		if (data_.Capacity() == size_) {
+			return;
+		}
+		AssertCapacityUnlocked();
+		const size_t old_capacity = data_.Capacity();
+		RawMemory<T, Alloc> new_data(size_, data_.GetAllocator());
+		NoteAllocation(size_);
+		CopyOrMoveAndSwap(new_data);
+		NoteReallocation(old_capacity, size_, size_ * sizeof(T));
+	}
+
+	constexpr void Resize(size_t new_size) {
+		if (new_size < size_) {
+			std::destroy_n(data_ + new_size, size_ - new_size);
+		}
+		else if (new_size > size_) {
+			Reserve(new_size);
+			BulkDefaultConstruct(data_ + size_, new_size - size_);
+		}
+		size_ = new_size;
 	}
 
-	void Resize(size_t new_size) {
+	// Как Resize, но для тривиально конструируемых типов новые элементы остаются
+	// неинициализированными в расчёте на немедленную перезапись (recv, чтение файла)
+	void ResizeForOverwrite(size_t new_size) {
 		if (new_size < size_) {
 			std::destroy_n(data_ + new_size, size_ - new_size);
 		}
 		else if (new_size > size_) {
 			Reserve(new_size);
-			std::uninitialized_default_construct_n(data_ + size_, new_size - size_);
+			if constexpr (!std::is_trivially_default_constructible_v<T>) {
+				std::uninitialized_default_construct_n(data_ + size_, new_size - size_);
+			}
 		}
 		size_ = new_size;
 	}
 
-	void PushBack(const T& value) {
+	constexpr void PushBack(const T& value) {
 		EmplaceBack(value);
 	}
 
-	void PushBack(T&& value) {
+	constexpr void PushBack(T&& value) {
 		EmplaceBack(std::move(value));
 	}
 
-	void PopBack() {
+	constexpr void PopBack() {
 		std::destroy_at(data_ + size_ - 1);
 		--size_;
 	}
@@ -227,87 +774,543 @@ public:
 		return Emplace(pos, std::move(value));
 	}
 
+	// Добавляет в конец копии элементов [first, last); ёмкость резервируется один раз,
+	// без проверки size_ == Capacity() на каждом элементе
+	template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+	iterator AppendBack(InputIt first, InputIt last) {
+		// Диапазон обходится дважды (подсчёт + копирование) — однопроходных итераторов недостаточно
+		static_assert(std::is_base_of_v<std::forward_iterator_tag,
+			typename std::iterator_traits<InputIt>::iterator_category>,
+			"AppendBack requires forward iterators");
+		const size_t count = static_cast<size_t>(std::distance(first, last));
+		ReserveForInsert(count);
+		std::uninitialized_copy(first, last, data_ + size_);
+		size_ += count;
+		return Wrap(data_ + size_ - count);
+	}
+
+	// Добавляет в конец count копий value
+	iterator AppendBack(size_t count, const T& value) {
+		if (size_ + count > Capacity()) {
+			// value может указывать внутрь вектора и пережить реаллокацию
+			T value_copy(value);
+			ReserveForInsert(count);
+			std::uninitialized_fill_n(data_ + size_, count, value_copy);
+		}
+		else {
+			std::uninitialized_fill_n(data_ + size_, count, value);
+		}
+		size_ += count;
+		return Wrap(data_ + size_ - count);
+	}
+
+	// Заменяет содержимое копиями элементов [first, last), переиспользуя текущий
+	// буфер и живые элементы по образцу operator=(const Vector&); реаллокация —
+	// не более одной и только при нехватке ёмкости
+	template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+	void Assign(InputIt first, InputIt last) {
+		// Диапазон обходится дважды (подсчёт + копирование) — однопроходных итераторов недостаточно
+		static_assert(std::is_base_of_v<std::forward_iterator_tag,
+			typename std::iterator_traits<InputIt>::iterator_category>,
+			"Assign requires forward iterators");
+		const size_t count = static_cast<size_t>(std::distance(first, last));
+		if (count > Capacity()) {
+			AssertCapacityUnlocked();
+			// Старое содержимое всё равно выбрасывается — копировать его в новый буфер незачем
+			RawMemory<T, Alloc> new_data(count, data_.GetAllocator());
+			NoteAllocation(count);
+			std::uninitialized_copy(first, last, new_data.GetAddress());
+			BulkDestroy(data_.GetAddress(), size_);
+			data_.Swap(new_data);
+			BumpGeneration();
+		}
+		else {
+			const size_t copy_count = count < size_ ? count : size_;
+			InputIt mid = std::next(first, static_cast<typename std::iterator_traits<InputIt>::difference_type>(copy_count));
+			std::copy(first, mid, data_.GetAddress());
+			if (count < size_) {
+				std::destroy_n(data_ + count, size_ - count);
+			}
+			else {
+				std::uninitialized_copy(mid, last, data_ + size_);
+			}
+		}
+		size_ = count;
+	}
+
+	// Заменяет содержимое count копиями value
+	void Assign(size_t count, const T& value) {
+		if (count > Capacity()) {
+			// value может указывать внутрь вектора и пережить реаллокацию
+			T value_copy(value);
+			AssertCapacityUnlocked();
+			RawMemory<T, Alloc> new_data(count, data_.GetAllocator());
+			NoteAllocation(count);
+			std::uninitialized_fill_n(new_data.GetAddress(), count, value_copy);
+			BulkDestroy(data_.GetAddress(), size_);
+			data_.Swap(new_data);
+			BumpGeneration();
+		}
+		else {
+			const size_t fill_count = count < size_ ? count : size_;
+			std::fill_n(data_.GetAddress(), fill_count, value);
+			if (count < size_) {
+				std::destroy_n(data_ + count, size_ - count);
+			}
+			else {
+				std::uninitialized_fill_n(data_ + size_, count - size_, value);
+			}
+		}
+		size_ = count;
+	}
+
+	// Присваивает value всем элементам; байтовые типы заполняются одним memset
+	void Fill(const T& value) {
+		if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) == 1) {
+			unsigned char byte;
+			std::memcpy(&byte, &value, 1);
+			if (size_ != 0) {
+				std::memset(data_.GetAddress(), byte, size_);
+			}
+		}
+		else {
+			std::fill_n(data_.GetAddress(), size_, value);
+		}
+	}
+
+	// Ищет первый элемент, равный value. Для арифметических типов сравнение идёт
+	// блоками без раннего выхода — такой цикл компилятор векторизует, а выровненный
+	// аллокатор (AlignedVector) избавляет ядро и от peel-итераций в начале буфера
+	iterator Find(const T& value) {
+		T* raw_begin = data_.GetAddress();
+		if constexpr (std::is_arithmetic_v<T>) {
+			const size_t BLOCK = 64 / sizeof(T) < 4 ? 4 : 64 / sizeof(T);
+			const T* ptr = raw_begin;
+			size_t i = 0;
+			for (; i + BLOCK <= size_; i += BLOCK) {
+				bool any = false;
+				for (size_t j = 0; j < BLOCK; ++j) {
+					any |= ptr[i + j] == value;
+				}
+				if (any) {
+					break;
+				}
+			}
+			for (; i < size_; ++i) {
+				if (ptr[i] == value) {
+					return Wrap(raw_begin + i);
+				}
+			}
+			return Wrap(raw_begin + size_);
+		}
+		else {
+			return Wrap(std::find(raw_begin, raw_begin + size_, value));
+		}
+	}
+
+	const_iterator Find(const T& value) const {
+		return const_cast<Vector&>(*this).Find(value);
+	}
+
+	// Поэлементное сравнение; типы без padding-байтов сравниваются одним memcmp
+	bool Equal(const Vector& rhs) const {
+		if (size_ != rhs.size_) {
+			return false;
+		}
+		if constexpr (std::has_unique_object_representations_v<T>) {
+			return size_ == 0
+				|| std::memcmp(data_.GetAddress(), rhs.data_.GetAddress(), size_ * sizeof(T)) == 0;
+		}
+		else {
+			return std::equal(data_.GetAddress(), data_ + size_, rhs.data_.GetAddress());
+		}
+	}
+
+	// Вставляет копии элементов [first, last) перед pos за один сдвиг хвоста
+	template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+	iterator Insert(const_iterator pos, InputIt first, InputIt last) {
+		// Диапазон обходится дважды (подсчёт + копирование) — однопроходных итераторов недостаточно
+		static_assert(std::is_base_of_v<std::forward_iterator_tag,
+			typename std::iterator_traits<InputIt>::iterator_category>,
+			"Insert requires forward iterators");
+		const size_t dist_pos = static_cast<size_t>(Unwrap(pos) - data_.GetAddress());
+		const size_t count = static_cast<size_t>(std::distance(first, last));
+		if (count == 0) {
+			return Wrap(data_ + dist_pos);
+		}
+		if (size_ + count > Capacity()) {
+			AssertCapacityUnlocked();
+			const size_t grown = Growth::Grow(Capacity(), sizeof(T));
+			const size_t old_capacity = Capacity();
+			RawMemory<T, Alloc> new_data(size_ + count > grown ? size_ + count : grown, data_.GetAllocator());
+			NoteAllocation(new_data.Capacity());
+			NoteReallocation(old_capacity, new_data.Capacity(), size_ * sizeof(T));
+			std::uninitialized_copy(first, last, new_data + dist_pos);
+			if constexpr (IsTriviallyRelocatableV<T>) {
+				std::memcpy(static_cast<void*>(new_data.GetAddress()), data_.GetAddress(), dist_pos * sizeof(T));
+				std::memcpy(static_cast<void*>(new_data + dist_pos + count), data_ + dist_pos, (size_ - dist_pos) * sizeof(T));
+			}
+			else {
+				if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+					std::uninitialized_move_n(data_.GetAddress(), dist_pos, new_data.GetAddress());
+					std::uninitialized_move_n(data_ + dist_pos, size_ - dist_pos, new_data + dist_pos + count);
+				}
+				else {
+#if VECTOR_HAS_EXCEPTIONS
+					try {
+						std::uninitialized_copy_n(data_.GetAddress(), dist_pos, new_data.GetAddress());
+					}
+					catch (...) {
+						std::destroy_n(new_data + dist_pos, count);
+						throw;
+					}
+					try {
+						std::uninitialized_copy_n(data_ + dist_pos, size_ - dist_pos, new_data + dist_pos + count);
+					}
+					catch (...) {
+						std::destroy_n(new_data.GetAddress(), dist_pos + count);
+						throw;
+					}
+#else
+					std::uninitialized_copy_n(data_.GetAddress(), dist_pos, new_data.GetAddress());
+					std::uninitialized_copy_n(data_ + dist_pos, size_ - dist_pos, new_data + dist_pos + count);
+#endif
+				}
+				std::destroy_n(data_.GetAddress(), size_);
+			}
+			data_.Swap(new_data);
+			BumpGeneration();
+		}
+		else {
+			T* ins_pos = data_ + dist_pos;
+			T* raw_end = data_ + size_;
+			const size_t elems_after = size_ - dist_pos;
+			if constexpr (IsTriviallyRelocatableV<T>) {
+				// После memmove окно вставки — сырая память, элементы строятся заново
+				std::memmove(static_cast<void*>(ins_pos + count), ins_pos, elems_after * sizeof(T));
+				std::uninitialized_copy(first, last, ins_pos);
+			}
+			else if (count <= elems_after) {
+				std::uninitialized_move(raw_end - count, raw_end, raw_end);
+				std::move_backward(ins_pos, raw_end - count, raw_end);
+				std::copy(first, last, ins_pos);
+			}
+			else {
+				// Хвост целиком уезжает в неинициализированную область
+				std::uninitialized_move(ins_pos, raw_end, ins_pos + count);
+				InputIt mid = std::next(first, elems_after);
+				std::copy(first, mid, ins_pos);
+				std::uninitialized_copy(mid, last, raw_end);
+			}
+		}
+		size_ += count;
+		return Wrap(data_ + dist_pos);
+	}
+
 	iterator Erase(const_iterator pos) {
-		iterator res_pos = const_cast<iterator>(pos);
-		std::move(res_pos + 1, end(), res_pos);
-		PopBack();
-		return res_pos;
+		T* res_pos = const_cast<T*>(Unwrap(pos));
+		VectorTraceNote(VECTOR_TRACE_OP_ERASE, static_cast<size_t>(res_pos - data_.GetAddress()));
+		if constexpr (IsTriviallyRelocatableV<T>) {
+			std::destroy_at(res_pos);
+			std::memmove(static_cast<void*>(res_pos), res_pos + 1, (data_ + size_ - res_pos - 1) * sizeof(T));
+			--size_;
+		}
+		else {
+			std::move(res_pos + 1, data_ + size_, res_pos);
+			PopBack();
+		}
+		return Wrap(res_pos);
+	}
+
+	// Удаляет диапазон [first, last) за один сдвиг хвоста вместо k одиночных
+	iterator Erase(const_iterator first, const_iterator last) {
+		T* res_first = const_cast<T*>(Unwrap(first));
+		const size_t count = static_cast<size_t>(last - first);
+		if (count == 0) {
+			return Wrap(res_first);
+		}
+		if constexpr (IsTriviallyRelocatableV<T>) {
+			std::destroy_n(res_first, count);
+			std::memmove(static_cast<void*>(res_first), res_first + count, (data_ + size_ - res_first - count) * sizeof(T));
+		}
+		else {
+			T* new_end = std::move(res_first + count, data_ + size_, res_first);
+			std::destroy_n(new_end, count);
+		}
+		size_ -= count;
+		return Wrap(res_first);
+	}
+
+	// Удаляет элемент, не сохраняя порядок: на его место переезжает последний — O(1)
+	iterator EraseUnordered(const_iterator pos) {
+		T* res_pos = const_cast<T*>(Unwrap(pos));
+		if constexpr (IsTriviallyRelocatableV<T>) {
+			std::destroy_at(res_pos);
+			if (res_pos + 1 != data_ + size_) {
+				std::memcpy(static_cast<void*>(res_pos), data_ + size_ - 1, sizeof(T));
+			}
+			--size_;
+		}
+		else {
+			if (res_pos + 1 != data_ + size_) {
+				*res_pos = std::move(data_[size_ - 1u]);
+			}
+			PopBack();
+		}
+		return Wrap(res_pos);
 	}
 
 	template <typename... Args>
-	T& EmplaceBack(Args&&... args) {
+	constexpr T& EmplaceBack(Args&&... args) {
 		if (size_ == Capacity()) {
-			RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
-			new (new_data + size_) T(std::forward<Args>(args)...);
-			CopyOrMoveAndSwap(new_data);
+			if constexpr (IsTriviallyRelocatableV<T> && HasReallocate<Alloc, T>::value) {
+				// Аргументы могут указывать внутрь вектора — значение снимается до realloc
+				T new_elem(std::forward<Args>(args)...);
+				Reserve(Growth::Grow(Capacity(), sizeof(T)));
+				std::construct_at(data_ + size_, std::move(new_elem));
+			}
+			else {
+				AssertCapacityUnlocked();
+				const size_t old_capacity = Capacity();
+				RawMemory<T, Alloc> new_data(Growth::Grow(Capacity(), sizeof(T)), data_.GetAllocator());
+				NoteAllocation(new_data.Capacity());
+				std::construct_at(new_data + size_, std::forward<Args>(args)...);
+				CopyOrMoveAndSwap(new_data);
+				NoteReallocation(old_capacity, Capacity(), size_ * sizeof(T));
+			}
 		}
 		else {
-			new (data_ + size_) T(std::forward<Args>(args)...);
+			std::construct_at(data_ + size_, std::forward<Args>(args)...);
 		}
 		++size_;
+		VectorTraceNote(VECTOR_TRACE_OP_APPEND, 1);
 		return data_[size_ - 1];
 	}
 
 	template <typename... Args>
 	iterator Emplace(const_iterator pos, Args&&... args) {
-		iterator res_pos = nullptr;
-		if (pos == cend()) {
+		T* res_pos = nullptr;
+		if (Unwrap(pos) == data_ + size_) {
 			res_pos = &EmplaceBack(std::forward<Args>(args)...);
 		}
 		else if (size_ == Capacity()) {
-			RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
-			const size_t dist_pos = pos - begin();
+			AssertCapacityUnlocked();
+			const size_t old_capacity = Capacity();
+			RawMemory<T, Alloc> new_data(Growth::Grow(Capacity(), sizeof(T)), data_.GetAllocator());
+			NoteAllocation(new_data.Capacity());
+			NoteReallocation(old_capacity, new_data.Capacity(), size_ * sizeof(T));
+			const size_t dist_pos = static_cast<size_t>(Unwrap(pos) - data_.GetAddress());
+			VectorTraceNote(VECTOR_TRACE_OP_INSERT, dist_pos);
 			new (new_data + dist_pos) T(std::forward<Args>(args)...);
-			if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-				std::uninitialized_move_n(begin(), dist_pos, new_data.GetAddress());
+			if constexpr (IsTriviallyRelocatableV<T>) {
+				// Обе половины старого буфера переносятся блочными копиями вокруг вставленного элемента
+				std::memcpy(static_cast<void*>(new_data.GetAddress()), data_.GetAddress(), dist_pos * sizeof(T));
+				std::memcpy(static_cast<void*>(new_data + dist_pos + 1), data_ + dist_pos, (size_ - dist_pos) * sizeof(T));
 			}
 			else {
-				try {
-					std::uninitialized_copy_n(begin(), dist_pos, new_data.GetAddress());
+				if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+					std::uninitialized_move_n(data_.GetAddress(), dist_pos, new_data.GetAddress());
 				}
-				catch (...) {
-					std::destroy_at(new_data + dist_pos);
+				else {
+#if VECTOR_HAS_EXCEPTIONS
+					try {
+						std::uninitialized_copy_n(data_.GetAddress(), dist_pos, new_data.GetAddress());
+					}
+					catch (...) {
+						std::destroy_at(new_data + dist_pos);
+						throw;
+					}
+#else
+					std::uninitialized_copy_n(data_.GetAddress(), dist_pos, new_data.GetAddress());
+#endif
 				}
-			}
-			if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-				std::uninitialized_move_n(data_ + dist_pos, size_ - dist_pos, new_data + dist_pos + 1);
-			}
-			else {
-				try {
-					std::uninitialized_copy_n(data_ + dist_pos, size_ - dist_pos, new_data + dist_pos + 1);
+				if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+					std::uninitialized_move_n(data_ + dist_pos, size_ - dist_pos, new_data + dist_pos + 1);
 				}
-				catch (...) {
-					std::destroy_n(new_data.GetAddress(), dist_pos + 1);
+				else {
+#if VECTOR_HAS_EXCEPTIONS
+					try {
+						std::uninitialized_copy_n(data_ + dist_pos, size_ - dist_pos, new_data + dist_pos + 1);
+					}
+					catch (...) {
+						std::destroy_n(new_data.GetAddress(), dist_pos + 1);
+						throw;
+					}
+#else
+					std::uninitialized_copy_n(data_ + dist_pos, size_ - dist_pos, new_data + dist_pos + 1);
+#endif
 				}
+				std::destroy_n(data_.GetAddress(), size_);
 			}
-			std::destroy_n(begin(), size_);
 			data_.Swap(new_data);
-			res_pos = begin() + dist_pos;
+			BumpGeneration();
+			res_pos = data_ + dist_pos;
 			++size_;
 		}
 		else {
 			T new_elem(std::forward<Args>(args)...);
-			new (data_ + size_) T(std::move(data_[size_ - 1u]));
-			res_pos = const_cast<iterator>(pos);
-			std::move_backward(res_pos, std::prev(end()), end());
-			*res_pos = std::move(new_elem);
+			res_pos = const_cast<T*>(Unwrap(pos));
+			VectorTraceNote(VECTOR_TRACE_OP_INSERT, static_cast<size_t>(res_pos - data_.GetAddress()));
+			T* raw_end = data_ + size_;
+			if constexpr (IsTriviallyRelocatableV<T>) {
+				std::memmove(static_cast<void*>(res_pos + 1), res_pos, (raw_end - res_pos) * sizeof(T));
+				new (res_pos) T(std::move(new_elem));
+			}
+			else {
+				new (data_ + size_) T(std::move(data_[size_ - 1u]));
+				std::move_backward(res_pos, std::prev(raw_end), raw_end);
+				*res_pos = std::move(new_elem);
+			}
 			++size_;
 		}
-		return res_pos;
+		return Wrap(res_pos);
 	}
 
 private:
-	RawMemory<T> data_;
+	RawMemory<T, Alloc> data_;
 	size_t size_ = 0;
+	bool capacity_locked_ = false;
 
-	void CopyOrMoveAndSwap(RawMemory<T>& new_data) {
+	// Срабатывает в начале каждой ветки, заводящей новый буфер
+	constexpr void AssertCapacityUnlocked() const {
+		if (!capacity_locked_) {
+			return;
+		}
+#if VECTOR_HAS_EXCEPTIONS
+		throw std::length_error("Vector: reallocation with locked capacity");
+#else
+		assert(false && "Vector: reallocation with locked capacity");
+		std::abort();
+#endif
+	}
+#if defined(VECTOR_CHECKED)
+	size_t generation_ = 0;
+#endif
+
+	// Обёртка/развёртка итераторов отладочного режима; в релизе — тождественные
+	constexpr iterator Wrap(T* ptr) noexcept {
+#if defined(VECTOR_CHECKED)
+		return iterator(ptr, this);
+#else
+		return ptr;
+#endif
+	}
+
+	constexpr const_iterator Wrap(const T* ptr) const noexcept {
+#if defined(VECTOR_CHECKED)
+		return const_iterator(ptr, this);
+#else
+		return ptr;
+#endif
+	}
+
+	constexpr const T* Unwrap(const_iterator pos) const VECTOR_NOEXCEPT_UNCHECKED {
+#if defined(VECTOR_CHECKED)
+		pos.Validate();
+		return pos.ptr_;
+#else
+		return pos;
+#endif
+	}
+
+	// Поколение буфера растёт при каждой реаллокации — по нему итераторы
+	// отладочного режима распознают инвалидацию
+	constexpr void BumpGeneration() noexcept {
+#if defined(VECTOR_CHECKED)
+		++generation_;
+#endif
+	}
+
+	// Учёт событий для VECTOR_STATS; без него вызовы пустые и кода не порождают
+	static constexpr void NoteAllocation(size_t new_capacity) noexcept {
+#if defined(VECTOR_STATS)
+		if (std::is_constant_evaluated()) {
+			return;
+		}
+		VectorStats& stats = GetStats();
+		++stats.allocations;
+		if (new_capacity > stats.peak_capacity) {
+			stats.peak_capacity = new_capacity;
+		}
+#else
+		(void)new_capacity;
+#endif
+	}
+
+	static constexpr void NoteReallocation(size_t old_capacity, size_t new_capacity, size_t bytes_moved) noexcept {
+#if defined(VECTOR_STATS)
+		if (std::is_constant_evaluated()) {
+			return;
+		}
+		if (old_capacity == 0) {
+			// Первое выделение уже учтено в NoteAllocation
+			return;
+		}
+		VectorStats& stats = GetStats();
+		++stats.reallocations;
+		stats.bytes_copied += bytes_moved;
+		if (new_capacity > stats.peak_capacity) {
+			stats.peak_capacity = new_capacity;
+		}
+		if (stats.on_reallocation != nullptr) {
+			stats.on_reallocation(old_capacity, new_capacity);
+		}
+#else
+		(void)old_capacity;
+		(void)new_capacity;
+		(void)bytes_moved;
+#endif
+	}
+
+	// Гарантирует место под count дополнительных элементов за не более чем одну реаллокацию
+	constexpr void ReserveForInsert(size_t count) {
+		if (size_ + count > Capacity()) {
+			const size_t grown = Growth::Grow(Capacity(), sizeof(T));
+			Reserve(size_ + count > grown ? size_ + count : grown);
+		}
+	}
+
+	// Копирующее присваивание в пределах текущей ёмкости: живые элементы
+	// перезаписываются, строится или разрушается только хвост
+	constexpr void AssignPreservingElements(const Vector& rhs) {
+		const size_t copy_count = rhs.Size() < size_ ? rhs.Size() : size_;
+		std::copy(rhs.data_.GetAddress(), rhs.data_ + copy_count, data_.GetAddress());
+		if (rhs.Size() < size_) {
+			std::destroy_n(data_ + rhs.Size(), size_ - rhs.Size());
+		}
+		else if (rhs.Size() > size_) {
+			BulkCopyConstruct(rhs.data_ + size_, rhs.Size() - size_, data_.GetAddress() + size_);
+		}
+		size_ = rhs.Size();
+	}
+
+	constexpr void CopyOrMoveAndSwap(RawMemory<T, Alloc>& new_data) {
+		if (std::is_constant_evaluated()) {
+			for (size_t i = 0; i < size_; ++i) {
+				std::construct_at(new_data + i, std::move(data_[i]));
+			}
+			std::destroy_n(data_.GetAddress(), size_);
+			data_.Swap(new_data);
+			BumpGeneration();
+			return;
+		}
+		if constexpr (IsTriviallyRelocatableV<T>) {
+			// Тривиально перемещаемые типы переносятся одним блочным memcpy без вызова деструкторов
+			if (size_ != 0) {
+				std::memcpy(static_cast<void*>(new_data.GetAddress()), data_.GetAddress(), size_ * sizeof(T));
+			}
+			data_.Swap(new_data);
+			BumpGeneration();
+			return;
+		}
 		if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
 			std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
 		}
 		else {
 			std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
 		}
-		std::destroy_n(data_.GetAddress(), size_);
+		BulkDestroy(data_.GetAddress(), size_);
 		data_.Swap(new_data);
+		BumpGeneration();
 	}
 };
\ No newline at end of file
@@ -0,0 +1,72 @@
+﻿#pragma once
+#include "vector.h"
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+
+// Потоковая сериализация вектора тривиально копируемых элементов: полезная
+// нагрузка уходит в поток и приходит из него одним bulk-вызовом write/read,
+// без промежуточного staging-буфера и поэлементного цикла.
+//
+// Формат кадра: два поля uint64 little-endian — размер элемента и число
+// элементов, затем сырые байты элементов в порядке их представления в памяти.
+// Формат рассчитан на обмен между little-endian машинами (x86-64, AArch64)
+
+inline void WriteLittleEndian64(std::ostream& out, uint64_t value) {
+	unsigned char bytes[8];
+	for (size_t i = 0; i < 8; ++i) {
+		bytes[i] = static_cast<unsigned char>(value >> (8u * i));
+	}
+	out.write(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+
+inline uint64_t ReadLittleEndian64(std::istream& in) {
+	unsigned char bytes[8] = {};
+	in.read(reinterpret_cast<char*>(bytes), sizeof(bytes));
+	uint64_t value = 0;
+	for (size_t i = 0; i < 8; ++i) {
+		value |= uint64_t{bytes[i]} << (8u * i);
+	}
+	return value;
+}
+
+// Пишет кадр целиком: заголовок и одна блочная запись содержимого
+template <typename T, typename Alloc, typename Growth>
+void WriteTo(const Vector<T, Alloc, Growth>& v, std::ostream& out) {
+	static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements have a defined wire layout");
+	WriteLittleEndian64(out, sizeof(T));
+	WriteLittleEndian64(out, v.Size());
+	if (v.Size() != 0) {
+		out.write(reinterpret_cast<const char*>(v.Data()), static_cast<std::streamsize>(v.Size() * sizeof(T)));
+	}
+	if (!out) {
+		throw std::runtime_error("WriteTo: stream write failed");
+	}
+}
+
+// Читает count элементов без заголовка прямо в буфер вектора: место под них
+// резервируется через ResizeForOverwrite, конструированием байты не затираются
+template <typename T, typename Alloc, typename Growth>
+void ReadFrom(Vector<T, Alloc, Growth>& v, std::istream& in, size_t count) {
+	static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable elements have a defined wire layout");
+	v.ResizeForOverwrite(count);
+	if (count != 0) {
+		in.read(reinterpret_cast<char*>(v.Data()), static_cast<std::streamsize>(count * sizeof(T)));
+	}
+	if (!in) {
+		throw std::runtime_error("ReadFrom: stream read failed");
+	}
+}
+
+// Читает кадр, записанный WriteTo: проверяет размер элемента и забирает содержимое
+template <typename T, typename Alloc, typename Growth>
+void ReadFrom(Vector<T, Alloc, Growth>& v, std::istream& in) {
+	const uint64_t elem_size = ReadLittleEndian64(in);
+	const uint64_t count = ReadLittleEndian64(in);
+	if (!in || elem_size != sizeof(T)) {
+		throw std::runtime_error("ReadFrom: frame header mismatch");
+	}
+	ReadFrom(v, in, static_cast<size_t>(count));
+}
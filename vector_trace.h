@@ -0,0 +1,99 @@
+﻿#pragma once
+#include "vector.h"
+#include "vector_io.h"
+
+// Компактный формат трасс операций для прогонов движков на реальных паттернах
+// доступа: последовательность событий {операция, аргумент}. Аргумент — число
+// элементов для APPEND/SCAN и индекс для INSERT/ERASE; SNAPSHOT аргумента не
+// имеет. Сериализация — кадром vector_io, трассы переносимы между машинами.
+// Регистратор подключается к крючку vector_trace_hook инструментированной
+// сборки (VECTOR_TRACE) и захватывает трассу с боевого кода без его правки
+enum class TraceOp : uint8_t {
+	APPEND = VECTOR_TRACE_OP_APPEND,
+	INSERT = VECTOR_TRACE_OP_INSERT,
+	ERASE = VECTOR_TRACE_OP_ERASE,
+	SCAN = 3,
+	SNAPSHOT = 4,
+};
+
+struct TraceEvent {
+	uint64_t op;
+	uint64_t arg;
+};
+
+class Trace {
+public:
+	size_t Size() const noexcept {
+		return events_.Size();
+	}
+
+	const TraceEvent& operator[](size_t index) const noexcept {
+		return events_[index];
+	}
+
+	const TraceEvent* begin() const noexcept {
+		return events_.Data();
+	}
+
+	const TraceEvent* end() const noexcept {
+		return events_.Data() + events_.Size();
+	}
+
+	void Note(TraceOp op, uint64_t arg = 0) {
+		// Подряд идущие одиночные APPEND склеиваются в одно событие-пачку
+		if (op == TraceOp::APPEND && events_.Size() != 0) {
+			TraceEvent& last = events_[events_.Size() - 1u];
+			if (last.op == static_cast<uint64_t>(TraceOp::APPEND)) {
+				last.arg += arg;
+				return;
+			}
+		}
+		events_.PushBack(TraceEvent{static_cast<uint64_t>(op), arg});
+	}
+
+	void Save(std::ostream& out) const {
+		WriteTo(events_, out);
+	}
+
+	void Load(std::istream& in) {
+		ReadFrom(events_, in);
+	}
+
+private:
+	Vector<TraceEvent> events_;
+};
+
+#if defined(VECTOR_TRACE)
+// Регистратор: пока жив, структурные операции всех Vector пишутся в трассу.
+// Одновременно активен не более одного регистратора
+class TraceRecorder {
+public:
+	explicit TraceRecorder(Trace& trace) {
+		assert(active_ == nullptr);
+		active_ = &trace;
+		vector_trace_hook = &Forward;
+	}
+
+	~TraceRecorder() {
+		vector_trace_hook = nullptr;
+		active_ = nullptr;
+	}
+
+	TraceRecorder(const TraceRecorder&) = delete;
+	TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+private:
+	static void Forward(uint8_t op, size_t arg) {
+		// Трасса сама растёт на Vector — её собственные операции не записываются
+		if (in_hook_) {
+			return;
+		}
+		in_hook_ = true;
+		active_->Note(static_cast<TraceOp>(op), arg);
+		in_hook_ = false;
+	}
+
+	inline static Trace* active_ = nullptr;
+	inline static bool in_hook_ = false;
+};
+#endif